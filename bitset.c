@@ -0,0 +1,188 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2025 Jacob Adams
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define BITSET_X86
+#endif
+
+#include "bitset.h"
+#include "constants.h"
+
+/************************************************************
+ * Scalar kernels
+ ************************************************************/
+static int hasContradictionInRowsScalar(const long* rows, int numRows, int numWords)
+{
+    long found = 0;
+    for (int row = 0; row < numRows; row++)
+    {
+        const long* words = rows + row*FUNCTION_RESULT_SIZE;
+        for (int i = 0; i < numWords; i++)
+        {
+            //See hasExplicitContradiction()
+            found |= ((words[i] & ODD_FUNCTION_MASK) << 1) & words[i];
+        }
+    }
+    return found != 0;
+}
+
+static void mergeRowsScalar(long* dest, const long* src, int numRows, int numWords)
+{
+    for (int row = 0; row < numRows; row++)
+    {
+        for (int i = 0; i < numWords; i++)
+        {
+            dest[row*FUNCTION_RESULT_SIZE + i] |= src[row*FUNCTION_RESULT_SIZE + i];
+        }
+    }
+}
+
+#ifdef BITSET_X86
+/************************************************************
+ * SSE2 kernels (2 words at a time)
+ ************************************************************/
+__attribute__((target("sse2")))
+static int hasContradictionInRowsSSE2(const long* rows, int numRows, int numWords)
+{
+    const __m128i odd = _mm_set1_epi64x(ODD_FUNCTION_MASK);
+    const int width = (numWords + 3) & ~3;
+
+    //Two accumulators to keep both vector units busy
+    __m128i found0 = _mm_setzero_si128();
+    __m128i found1 = _mm_setzero_si128();
+    for (int row = 0; row < numRows; row++)
+    {
+        const long* words = rows + row*FUNCTION_RESULT_SIZE;
+        for (int i = 0; i < width; i += 4)
+        {
+            __m128i w0 = _mm_loadu_si128((const __m128i*) (words + i));
+            __m128i w1 = _mm_loadu_si128((const __m128i*) (words + i + 2));
+            found0 = _mm_or_si128(found0, _mm_and_si128(_mm_slli_epi64(_mm_and_si128(w0, odd), 1), w0));
+            found1 = _mm_or_si128(found1, _mm_and_si128(_mm_slli_epi64(_mm_and_si128(w1, odd), 1), w1));
+        }
+    }
+    __m128i found = _mm_or_si128(found0, found1);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(found, _mm_setzero_si128())) != 0xFFFF;
+}
+
+__attribute__((target("sse2")))
+static void mergeRowsSSE2(long* dest, const long* src, int numRows, int numWords)
+{
+    const int width = (numWords + 1) & ~1;
+    for (int row = 0; row < numRows; row++)
+    {
+        long* d = dest + row*FUNCTION_RESULT_SIZE;
+        const long* s = src + row*FUNCTION_RESULT_SIZE;
+        for (int i = 0; i < width; i += 2)
+        {
+            __m128i w = _mm_or_si128(_mm_loadu_si128((const __m128i*) (d + i)), _mm_loadu_si128((const __m128i*) (s + i)));
+            _mm_storeu_si128((__m128i*) (d + i), w);
+        }
+    }
+}
+
+/************************************************************
+ * AVX2 kernels (4 words at a time)
+ ************************************************************/
+__attribute__((target("avx2")))
+static int hasContradictionInRowsAVX2(const long* rows, int numRows, int numWords)
+{
+    const __m256i odd = _mm256_set1_epi64x(ODD_FUNCTION_MASK);
+    const int width = (numWords + 3) & ~3;
+
+    __m256i found = _mm256_setzero_si256();
+    for (int row = 0; row < numRows; row++)
+    {
+        const long* words = rows + row*FUNCTION_RESULT_SIZE;
+        for (int i = 0; i < width; i += 4)
+        {
+            __m256i w = _mm256_loadu_si256((const __m256i*) (words + i));
+            found = _mm256_or_si256(found, _mm256_and_si256(_mm256_slli_epi64(_mm256_and_si256(w, odd), 1), w));
+        }
+    }
+    return !_mm256_testz_si256(found, found);
+}
+
+__attribute__((target("avx2")))
+static void mergeRowsAVX2(long* dest, const long* src, int numRows, int numWords)
+{
+    const int width = (numWords + 3) & ~3;
+    for (int row = 0; row < numRows; row++)
+    {
+        long* d = dest + row*FUNCTION_RESULT_SIZE;
+        const long* s = src + row*FUNCTION_RESULT_SIZE;
+        for (int i = 0; i < width; i += 4)
+        {
+            __m256i w = _mm256_or_si256(_mm256_loadu_si256((const __m256i*) (d + i)), _mm256_loadu_si256((const __m256i*) (s + i)));
+            _mm256_storeu_si256((__m256i*) (d + i), w);
+        }
+    }
+}
+#endif
+
+/************************************************************
+ * Dispatch
+ ************************************************************/
+int (*hasContradictionInRows)(const long* rows, int numRows, int numWords) = hasContradictionInRowsScalar;
+void (*mergeRows)(long* dest, const long* src, int numRows, int numWords) = mergeRowsScalar;
+
+static const char* BITSET_KERNELS_NAME = "scalar";
+
+/**
+ * initBitsetKernels() - pick the widest version of the kernels the CPU supports (AVX2, SSE2 or scalar)
+ * until this is called the scalar versions are used
+*/
+void initBitsetKernels()
+{
+#ifdef BITSET_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        hasContradictionInRows = hasContradictionInRowsAVX2;
+        mergeRows = mergeRowsAVX2;
+        BITSET_KERNELS_NAME = "avx2";
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        hasContradictionInRows = hasContradictionInRowsSSE2;
+        mergeRows = mergeRowsSSE2;
+        BITSET_KERNELS_NAME = "sse2";
+    }
+#endif
+}
+
+/**
+ * getBitsetKernelsName() - the name of the kernels picked by initBitsetKernels()
+ * 
+ * @return "avx2", "sse2" or "scalar"
+*/
+const char* getBitsetKernelsName()
+{
+    return BITSET_KERNELS_NAME;
+}
@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2025 Jacob Adams
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "constants.h"
+
+//Every odd bit set, the NOT_X half of each function pair X = 2n, NOT_X = 2n+1
+#define ODD_FUNCTION_MASK 6148914691236517205L
+
+/**
+ * hasContradictionInWord() - returns if a word has both a function and its negation set
+ * 
+ * @word - the word to check
+ * 
+ * @return TRUE if a contradiction was found
+*/
+static inline int hasContradictionInWord(long word)
+{
+    return (((word & ODD_FUNCTION_MASK) << 1) & word) != 0;
+}
+
+/*
+ * Kernels over the rows of a knowledge base
+ * a row is the FUNCTION_RESULT_SIZE words of one element, the rows of a set are contiguous
+ *
+ * Rows are processed a whole vector at a time so words past numWords may also be read,
+ * these are always 0 in a knowledge base
+*/
+
+/**
+ * initBitsetKernels() - pick the widest version of the kernels the CPU supports (AVX2, SSE2 or scalar)
+ * until this is called the scalar versions are used
+*/
+void initBitsetKernels();
+
+/**
+ * getBitsetKernelsName() - the name of the kernels picked by initBitsetKernels()
+ * 
+ * @return "avx2", "sse2" or "scalar"
+*/
+const char* getBitsetKernelsName();
+
+/**
+ * hasContradictionInRows() - returns if any row has both a function and its negation set
+ * functions are stored in pairs X = 2n, NOT_X = 2n+1
+ * 
+ * @rows - the first row
+ * @numRows - the number of rows to check
+ * @numWords - the number of words to check in each row
+ * 
+ * @return TRUE if a contradiction was found
+*/
+extern int (*hasContradictionInRows)(const long* rows, int numRows, int numWords);
+
+/**
+ * mergeRows() - OR rows of src into dest
+ * 
+ * @dest - the first row to merge into (inline)
+ * @src - the first row to merge from
+ * @numRows - the number of rows to merge
+ * @numWords - the number of words to merge in each row
+*/
+extern void (*mergeRows)(long* dest, const long* src, int numRows, int numWords);
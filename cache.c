@@ -0,0 +1,323 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2025 Jacob Adams
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "cache.h"
+#include "knowledge.h"
+#include "constants.h"
+#include "scripts.h"
+#include "util.h"
+
+/**
+ * initCachedKB() - create an empty world cache
+ * 
+ * @kb - knowledge base the cached worlds are for
+ * @capacity - the most worlds the cache holds
+ * @seed - seed for choosing which worlds to evict
+ * 
+ * @return the cache
+*/
+CachedKnowledgeBases* initCachedKB(KnowledgeBase* kb, int capacity, unsigned long seed)
+{
+    //Allocate memory
+    CachedKnowledgeBases* cache = (CachedKnowledgeBases*) malloc(sizeof(CachedKnowledgeBases));
+    if (cache == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    cache->CAPACITY = capacity;
+    cache->POSSIBLE_WORLDS_FOR_PROB = (KnowledgeBase**) malloc(capacity*sizeof(KnowledgeBase*));
+    cache->value = (double*) malloc(capacity*sizeof(double));
+    cache->FREE_SLOTS = (int*) malloc(capacity*sizeof(int));
+    cache->LIVE_SLOTS = (int*) malloc(capacity*sizeof(int));
+    cache->LIVE_POSITION = (int*) malloc(capacity*sizeof(int));
+    if (cache->POSSIBLE_WORLDS_FOR_PROB == NULL || cache->value == NULL || 
+        cache->FREE_SLOTS == NULL || cache->LIVE_SLOTS == NULL || cache->LIVE_POSITION == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+
+    //Slots are handed out lowest first
+    for (int slot = 0; slot < capacity; slot++)
+    {
+        cache->POSSIBLE_WORLDS_FOR_PROB[slot] = NULL;
+        cache->value[slot] = NAN;
+        cache->FREE_SLOTS[capacity-1-slot] = slot;
+        cache->LIVE_POSITION[slot] = -1;
+    }
+    cache->NUM_FREE = capacity;
+    cache->NUM_LIVE = 0;
+    cache->NUM_OFFERED = 0;
+    initRandState(&cache->rng, seed);
+
+    char buff[STRING_BUFF_SIZE];
+    for (int night = 0; night < NUM_DAYS; night++)
+    {
+        for (int role = 0; role < NUM_BOTCT_ROLES; role++)
+        {
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
+            cache->ROLE_FUNCTIONS[night][role] = getSetFunctionIDWithName(kb, 0, buff, 1);
+        }
+    }
+    for (int player = 0; player < MAX_SET_ELEMENTS; player++)
+    {
+        for (int role = 0; role < NUM_BOTCT_ROLES; role++)
+        {
+            for (int night = 0; night < NUM_DAYS; night++)
+            {
+                cache->EXAMPLE_WORLDS[player][role][night] = -1;
+                cache->EXAMPLE_COUNTS[player][role][night] = 0;
+            }
+        }
+    }
+    cache->NUM_RULES_INFERED = 0;
+
+    return cache;
+}
+
+/**
+ * getWorldRole() - find the role of a player in a world
+ * 
+ * @cache - the cache
+ * @world - the world
+ * @player - the elementID of the player
+ * @night - the night
+ * 
+ * @return the roleID, NUM_BOTCT_ROLES if the player has no role
+*/
+static int getWorldRole(CachedKnowledgeBases* cache, KnowledgeBase* world, int player, int night)
+{
+    int role = 0;
+    while (role < NUM_BOTCT_ROLES)
+    {
+        if (isKnown(world, 0, player, cache->ROLE_FUNCTIONS[night][role])) break;
+        role++;
+    }
+    return role;
+}
+
+/**
+ * addExampleWorld() - count a cached world in the example index
+ * and use it as the example for any (player, role, night) without one
+ * 
+ * @cache - the cache
+ * @slot - the slot of the world
+*/
+static void addExampleWorld(CachedKnowledgeBases* cache, int slot)
+{
+    KnowledgeBase* world = cache->POSSIBLE_WORLDS_FOR_PROB[slot];
+    for (int night = 0; night < NUM_DAYS; night++)
+    {
+        for (int player = 0; player < world->SET_SIZES[0]; player++)
+        {
+            int role = getWorldRole(cache, world, player, night);
+            if (role == NUM_BOTCT_ROLES) continue;
+            cache->EXAMPLE_COUNTS[player][role][night]++;
+            if (cache->EXAMPLE_WORLDS[player][role][night] == -1) cache->EXAMPLE_WORLDS[player][role][night] = slot;
+        }
+    }
+}
+
+/**
+ * findExampleWorld() - find a live world where a player is a role on a night
+ * 
+ * @cache - the cache
+ * @player - the elementID of the player
+ * @role - the roleID
+ * @night - the night
+ * 
+ * @return the slot of the world, -1 if there is none
+*/
+static int findExampleWorld(CachedKnowledgeBases* cache, int player, int role, int night)
+{
+    for (int position = 0; position < cache->NUM_LIVE; position++)
+    {
+        int slot = cache->LIVE_SLOTS[position];
+        if (isKnown(cache->POSSIBLE_WORLDS_FOR_PROB[slot], 0, player, cache->ROLE_FUNCTIONS[night][role])) return slot;
+    }
+    return -1;
+}
+
+/**
+ * addKBToCache() - offer a world to the cache, once full it replaces a random world
+ * with probability CAPACITY/NUM_OFFERED
+ * 
+ * @cache - the cache
+ * @kb - the world to copy into the cache
+ * @value - the weight of the world
+ * 
+ * @return the slot the world was stored in, -1 if it wasn't kept
+*/
+int addKBToCache(CachedKnowledgeBases* cache, KnowledgeBase* kb, double value)
+{
+    cache->NUM_OFFERED++;
+    if (cache->NUM_FREE == 0)
+    {
+        if (cache->NUM_LIVE == 0) return -1; //No capacity
+
+        //Reservoir sampling, every world offered has the same chance of being in the cache
+        double rand = (double) (getRandLong(&cache->rng) >> 11) * 0x1.0p-53 * cache->NUM_OFFERED;
+        if (rand >= cache->NUM_LIVE) return -1;
+        removeKBFromCache(cache, cache->LIVE_SLOTS[(int) rand]);
+    }
+
+    cache->NUM_FREE--;
+    int slot = cache->FREE_SLOTS[cache->NUM_FREE];
+    if (cache->POSSIBLE_WORLDS_FOR_PROB[slot] == NULL) cache->POSSIBLE_WORLDS_FOR_PROB[slot] = initKBFromTemplate(kb);
+    copyTo(cache->POSSIBLE_WORLDS_FOR_PROB[slot], kb);
+    cache->value[slot] = value;
+
+    cache->LIVE_POSITION[slot] = cache->NUM_LIVE;
+    cache->LIVE_SLOTS[cache->NUM_LIVE] = slot;
+    cache->NUM_LIVE++;
+
+    addExampleWorld(cache, slot);
+    return slot;
+}
+
+/**
+ * removeKBFromCache() - free the slot of a cached world,
+ * examples it was used for move to another live world with the same role if there is one
+ * 
+ * @cache - the cache
+ * @slot - the slot to free
+*/
+void removeKBFromCache(CachedKnowledgeBases* cache, int slot)
+{
+    if (cache->LIVE_POSITION[slot] == -1) return; //Already free
+    cache->value[slot] = NAN;
+
+    //Swap the last live slot into the gap
+    int position = cache->LIVE_POSITION[slot];
+    int last = cache->LIVE_SLOTS[cache->NUM_LIVE-1];
+    cache->LIVE_SLOTS[position] = last;
+    cache->LIVE_POSITION[last] = position;
+    cache->LIVE_POSITION[slot] = -1;
+    cache->NUM_LIVE--;
+
+    cache->FREE_SLOTS[cache->NUM_FREE] = slot;
+    cache->NUM_FREE++;
+
+    //Examples must never point at a free slot, the world stays in the slot until it is reused
+    //the counts say if another live world can take its place without searching for nothing
+    KnowledgeBase* world = cache->POSSIBLE_WORLDS_FOR_PROB[slot];
+    for (int night = 0; night < NUM_DAYS; night++)
+    {
+        for (int player = 0; player < world->SET_SIZES[0]; player++)
+        {
+            int role = getWorldRole(cache, world, player, night);
+            if (role == NUM_BOTCT_ROLES) continue;
+            cache->EXAMPLE_COUNTS[player][role][night]--;
+            if (cache->EXAMPLE_WORLDS[player][role][night] != slot) continue;
+
+            cache->EXAMPLE_WORLDS[player][role][night] = -1;
+            if (cache->EXAMPLE_COUNTS[player][role][night] > 0) cache->EXAMPLE_WORLDS[player][role][night] = findExampleWorld(cache, player, role, night);
+        }
+    }
+}
+
+/**
+ * removeInvalidKBsFromCache() - free the slots of worlds marked invalid (value NAN)
+ * and refill the example worlds from the worlds left
+ * 
+ * @cache - the cache
+*/
+void removeInvalidKBsFromCache(CachedKnowledgeBases* cache)
+{
+    int numBefore = cache->NUM_LIVE;
+
+    //Clear the examples rather than fix them up world by world, every one is refilled below
+    for (int player = 0; player < MAX_SET_ELEMENTS; player++)
+    {
+        for (int role = 0; role < NUM_BOTCT_ROLES; role++)
+        {
+            for (int night = 0; night < NUM_DAYS; night++)
+            {
+                cache->EXAMPLE_WORLDS[player][role][night] = -1;
+                cache->EXAMPLE_COUNTS[player][role][night] = 0;
+            }
+        }
+    }
+
+    for (int position = cache->NUM_LIVE-1; position >= 0; position--)
+    {
+        int slot = cache->LIVE_SLOTS[position];
+        if (isnan(cache->value[slot]) == 0) continue;
+
+        //Only the last live slot moves, and it has already been checked
+        int last = cache->LIVE_SLOTS[cache->NUM_LIVE-1];
+        cache->LIVE_SLOTS[position] = last;
+        cache->LIVE_POSITION[last] = position;
+        cache->LIVE_POSITION[slot] = -1;
+        cache->NUM_LIVE--;
+
+        cache->FREE_SLOTS[cache->NUM_FREE] = slot;
+        cache->NUM_FREE++;
+    }
+
+    //Worlds offered earlier were as likely to be invalid as the cached ones
+    if (numBefore > 0) cache->NUM_OFFERED *= (double) cache->NUM_LIVE / numBefore;
+
+    for (int position = 0; position < cache->NUM_LIVE; position++)
+    {
+        addExampleWorld(cache, cache->LIVE_SLOTS[position]);
+    }
+}
+
+/**
+ * getExampleWorld() - find a cached world where a player is a role on a night
+ * 
+ * @cache - the cache
+ * @player - the elementID of the player
+ * @role - the roleID
+ * @night - the night
+ * 
+ * @return the slot of the world, -1 if there is none
+*/
+int getExampleWorld(CachedKnowledgeBases* cache, int player, int role, int night)
+{
+    if (player < 0 || player >= MAX_SET_ELEMENTS || role < 0 || role >= NUM_BOTCT_ROLES || night < 0 || night >= NUM_DAYS) return -1;
+    return cache->EXAMPLE_WORLDS[player][role][night];
+}
+
+/**
+ * resetProbKBWithCache() - tally every world in the cache
+ * 
+ * @tally - OUTPUTS the tally of the cached worlds
+ * @cache - the cache
+*/
+void resetProbKBWithCache(ProbKnowledgeBase* tally, CachedKnowledgeBases* cache)
+{
+    resetProbKnowledgeBase(tally);
+    for (int position = 0; position < cache->NUM_LIVE; position++)
+    {
+        int slot = cache->LIVE_SLOTS[position];
+        addKBtoProbTally(cache->POSSIBLE_WORLDS_FOR_PROB[slot], tally, cache->value[slot]);
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2025 Jacob Adams
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "constants.h"
+#include "knowledge.h"
+#include "scripts.h"
+#include "util.h"
+
+/*
+ * A bounded cache of worlds found by the samplers
+ * once full it keeps a uniform sample of every world offered to it (reservoir sampling)
+ * so long games keep a fresh sample in constant memory
+*/
+typedef struct {
+    KnowledgeBase** POSSIBLE_WORLDS_FOR_PROB; //World in each slot, allocated the first time the slot is used
+    double* value; //Weight of the world in each slot, NAN if the slot is free or its world was found invalid
+    int CAPACITY;
+
+    int* FREE_SLOTS; //Stack of free slots
+    int NUM_FREE;
+    int* LIVE_SLOTS; //Used slots packed together so a random one can be evicted
+    int* LIVE_POSITION; //Where each slot is in LIVE_SLOTS (-1 if free)
+    int NUM_LIVE;
+
+    double NUM_OFFERED; //Worlds offered that are still believed valid, a full cache keeps each with probability CAPACITY/NUM_OFFERED
+    RandState rng;
+
+    int ROLE_FUNCTIONS[NUM_DAYS][NUM_BOTCT_ROLES]; //Function ID of is_<role>_[NIGHT<night>]
+    int EXAMPLE_WORLDS[MAX_SET_ELEMENTS][NUM_BOTCT_ROLES][NUM_DAYS]; //Slot of a world where the player is the role that night, -1 if none
+    int EXAMPLE_COUNTS[MAX_SET_ELEMENTS][NUM_BOTCT_ROLES][NUM_DAYS]; //Live worlds where the player is the role that night
+
+    int NUM_RULES_INFERED; //Rules the cached worlds were last checked against, later rules are new to them
+} CachedKnowledgeBases;
+
+/**
+ * initCachedKB() - create an empty world cache
+ * 
+ * @kb - knowledge base the cached worlds are for
+ * @capacity - the most worlds the cache holds
+ * @seed - seed for choosing which worlds to evict
+ * 
+ * @return the cache
+*/
+CachedKnowledgeBases* initCachedKB(KnowledgeBase* kb, int capacity, unsigned long seed);
+
+/**
+ * addKBToCache() - offer a world to the cache, once full it replaces a random world
+ * with probability CAPACITY/NUM_OFFERED
+ * 
+ * @cache - the cache
+ * @kb - the world to copy into the cache
+ * @value - the weight of the world
+ * 
+ * @return the slot the world was stored in, -1 if it wasn't kept
+*/
+int addKBToCache(CachedKnowledgeBases* cache, KnowledgeBase* kb, double value);
+
+/**
+ * removeKBFromCache() - free the slot of a cached world,
+ * examples it was used for move to another live world with the same role if there is one
+ * 
+ * @cache - the cache
+ * @slot - the slot to free
+*/
+void removeKBFromCache(CachedKnowledgeBases* cache, int slot);
+
+/**
+ * removeInvalidKBsFromCache() - free the slots of worlds marked invalid (value NAN)
+ * and refill the example worlds from the worlds left
+ * 
+ * @cache - the cache
+*/
+void removeInvalidKBsFromCache(CachedKnowledgeBases* cache);
+
+/**
+ * getExampleWorld() - find a cached world where a player is a role on a night
+ * 
+ * @cache - the cache
+ * @player - the elementID of the player
+ * @role - the roleID
+ * @night - the night
+ * 
+ * @return the slot of the world, -1 if there is none
+*/
+int getExampleWorld(CachedKnowledgeBases* cache, int player, int role, int night);
+
+/**
+ * resetProbKBWithCache() - tally every world in the cache
+ * 
+ * @tally - OUTPUTS the tally of the cached worlds
+ * @cache - the cache
+*/
+void resetProbKBWithCache(ProbKnowledgeBase* tally, CachedKnowledgeBases* cache);
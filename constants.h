@@ -33,10 +33,10 @@
 #define MAX_SET_ELEMENTS 16
 #define FUNCTION_RESULT_SIZE 32
 
-#define MAX_CACHED_WORLDS 4096
+#define MAX_CACHED_WORLDS 4096 //Default capacity of the world cache
 
 #define MAX_VARS_IN_RULE 16
-#define MAX_NUM_RULES 65536
+#define MAX_COUNTED_IN_RULE 64
 
 #define NUM_DAYS 5
 
@@ -28,6 +28,7 @@
 #include <math.h>
 
 #include "knowledge.h"
+#include "bitset.h"
 #include "constants.h"
 #include "scripts.h"
 
@@ -180,6 +181,66 @@ static void writePoisonFunc(char *funcName[NUM_SETS][FUNCTION_RESULT_SIZE*INT_LE
     writeFuncNight(funcName, set, index, "is_POISONED", "is_NOT_POISONED", night, maxLen);
 }
 
+/**
+ * hashFunctionName() - hash a function name to the first slot to check in the name hash table
+ *
+ * @name - the name to hash
+ * 
+ * @return the slot
+*/
+static int hashFunctionName(char* name)
+{
+    //FNV-1a
+    unsigned long hash = 14695981039346656037UL;
+    for (char* c = name; *c != '\0'; c++)
+    {
+        hash ^= (unsigned char) *c;
+        hash *= 1099511628211UL;
+    }
+    return hash & (FUNCTION_NAME_HASH_SIZE-1);
+}
+
+/**
+ * buildFunctionNameHash() - index the function names of a set for fast lookup
+ *
+ * @schema - the schema to index
+ * @set - the setID of the functions
+ * @numFunctions - the number of functions written into the set
+*/
+static void buildFunctionNameHash(KnowledgeBaseSchema* schema, int set, int numFunctions)
+{
+    for (int i = 0; i < FUNCTION_NAME_HASH_SIZE; i++) schema->FUNCTION_NAME_HASH[set][i] = 0;
+
+    for (int function = 0; function < numFunctions; function++)
+    {
+        int slot = hashFunctionName(schema->FUNCTION_NAME[set][function]);
+        while (schema->FUNCTION_NAME_HASH[set][slot] != 0)
+        {
+            //Keep the first function with a name (same as a linear search)
+            if (strcmp(schema->FUNCTION_NAME[set][schema->FUNCTION_NAME_HASH[set][slot]-1], schema->FUNCTION_NAME[set][function]) == 0) break;
+            slot = (slot + 1) & (FUNCTION_NAME_HASH_SIZE-1);
+        }
+        if (schema->FUNCTION_NAME_HASH[set][slot] == 0) schema->FUNCTION_NAME_HASH[set][slot] = function+1;
+    }
+}
+
+/**
+ * allocKB() - allocate a knowledge base with every row starting on a cache line
+ * so the bitset kernels read whole aligned vectors
+ * 
+ * @return the KB (uninitialised)
+*/
+static KnowledgeBase* allocKB()
+{
+    void* kb = NULL;
+    if (posix_memalign(&kb, 64, sizeof(KnowledgeBase)) != 0)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    return (KnowledgeBase*) kb;
+}
+
 /**
  * initBlankKB() - allocate a knowledge base without any data
  * 
@@ -188,7 +249,9 @@ static void writePoisonFunc(char *funcName[NUM_SETS][FUNCTION_RESULT_SIZE*INT_LE
 KnowledgeBase* initBlankKB()
 {
     //Allocate memory
-    KnowledgeBase* kb = (KnowledgeBase*) malloc(sizeof(KnowledgeBase));
+    KnowledgeBase* kb = allocKB();
+    kb->TRAIL = NULL;
+    kb->SCHEMA = NULL;
 
     //Fill knowlegde base with zeroes
     resetKnowledgeBase(kb);
@@ -204,7 +267,9 @@ KnowledgeBase* initBlankKB()
 KnowledgeBase* initKBFromTemplate(KnowledgeBase* template)
 {
     //Allocate memory
-    KnowledgeBase* kb = (KnowledgeBase*) malloc(sizeof(KnowledgeBase));
+    KnowledgeBase* kb = allocKB();
+    kb->TRAIL = NULL;
+    kb->SCHEMA = NULL;
 
     //Fill knowlegde base with zeroes
     resetKnowledgeBase(kb);
@@ -224,13 +289,23 @@ KnowledgeBase* initKBFromTemplate(KnowledgeBase* template)
 */
 KnowledgeBase* initKB(const int NUM_PLAYERS)
 {
+    //Use the widest kernels the CPU has
+    initBitsetKernels();
+
     //Allocate memory
     KnowledgeBase* kb = initBlankKB();
+    KnowledgeBaseSchema* schema = (KnowledgeBaseSchema*) malloc(sizeof(KnowledgeBaseSchema));
+    if (schema == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    kb->SCHEMA = schema;
 
     //Set names
-    kb->SET_NAMES[0] = "PLAYERS";
-    kb->SET_NAMES[1] = "DAYS";
-    kb->SET_NAMES[2] = "METADATA";
+    schema->SET_NAMES[0] = "PLAYERS";
+    schema->SET_NAMES[1] = "DAYS";
+    schema->SET_NAMES[2] = "METADATA";
     //Set sizes
     kb->SET_SIZES[0] = NUM_PLAYERS; //NUM PLAYERS
     kb->SET_SIZES[1] = NUM_DAYS; //NUM DAYS
@@ -240,8 +315,8 @@ KnowledgeBase* initKB(const int NUM_PLAYERS)
     int index[3] = {0, 0, 0};
 
     //Allocate function name strings memory
-    initStrings(kb->FUNCTION_NAME, 64);
-    initElementStrings(kb->ELEMENT_NAMES, 255);
+    initStrings(schema->FUNCTION_NAME, 64);
+    initElementStrings(schema->ELEMENT_NAMES, 255);
 
     // ===========================================
     //  PLAYER FUNCTIONS
@@ -251,49 +326,49 @@ KnowledgeBase* initKB(const int NUM_PLAYERS)
     {
         for (int roleID = 0; roleID < NUM_BOTCT_ROLES; roleID++)
         {
-            writeRoleFunc(kb->FUNCTION_NAME, 0, index, ROLE_NAMES[roleID], "", night, 64);
+            writeRoleFunc(schema->FUNCTION_NAME, 0, index, ROLE_NAMES[roleID], "", night, 64);
         }
 
         //Teams
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "is_GOOD", "is_EVIL", night,64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "is_GOOD", "is_EVIL", night,64);
         //Classes
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "is_TOWNSFOLK", "is_NOT_TOWNSFOLK", night, 64);
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "is_OUTSIDER", "is_NOT_OUTSIDER", night, 64);
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "is_MINION", "is_NOT_MINION", night, 64);
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "is_DEMON", "is_NOT_DEMON", night, 64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "is_TOWNSFOLK", "is_NOT_TOWNSFOLK", night, 64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "is_OUTSIDER", "is_NOT_OUTSIDER", night, 64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "is_MINION", "is_NOT_MINION", night, 64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "is_DEMON", "is_NOT_DEMON", night, 64);
 
         //Poison
-        writePoisonFunc(kb->FUNCTION_NAME, 0, index, night, 64);
+        writePoisonFunc(schema->FUNCTION_NAME, 0, index, night, 64);
 
         //Deaths
-        writeDeathFunc(kb->FUNCTION_NAME, 0, index, night, 64);
+        writeDeathFunc(schema->FUNCTION_NAME, 0, index, night, 64);
         //Death Types
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "SLEEP_DEATH", "NOT_SLEEP_DEATH", night, 64);
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "HANGING_DEATH", "NOT_HANGING_DEATH", night, 64);
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "NOMINATION_DEATH", "NOT_NOMINATION_DEATH", night, 64);
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "RESURRECTED", "NOT_RESURRECTED", night, 64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "SLEEP_DEATH", "NOT_SLEEP_DEATH", night, 64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "HANGING_DEATH", "NOT_HANGING_DEATH", night, 64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "NOMINATION_DEATH", "NOT_NOMINATION_DEATH", night, 64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "RESURRECTED", "NOT_RESURRECTED", night, 64);
         //Role changed
-        writeFuncNight(kb->FUNCTION_NAME, 0, index, "is_ROLE_CHANGED", "is_NOT_ROLE_CHANGED", night, 64);
+        writeFuncNight(schema->FUNCTION_NAME, 0, index, "is_ROLE_CHANGED", "is_NOT_ROLE_CHANGED", night, 64);
         //Killed Player
         for (int playerID = 0; playerID < NUM_PLAYERS; playerID++)
         {
-            writeActionFunc(kb->FUNCTION_NAME, 0, index, "KILLED", playerID, night, 64);
-            writeActionFunc(kb->FUNCTION_NAME, 0, index, "POISONED", playerID, night, 64);
+            writeActionFunc(schema->FUNCTION_NAME, 0, index, "KILLED", playerID, night, 64);
+            writeActionFunc(schema->FUNCTION_NAME, 0, index, "POISONED", playerID, night, 64);
         }
 
 
     }
 
     //REDHERRING
-    writeFunc(kb->FUNCTION_NAME, 0, index, "is_REDHERRING", "is_NOT_REDHERRING", 64);
+    writeFunc(schema->FUNCTION_NAME, 0, index, "is_REDHERRING", "is_NOT_REDHERRING", 64);
     //Evil Twin Pair
-    writeFunc(kb->FUNCTION_NAME, 0, index, "is_GOOD_TWIN", "is_NOT_GOOD_TWIN", 64);
+    writeFunc(schema->FUNCTION_NAME, 0, index, "is_GOOD_TWIN", "is_NOT_GOOD_TWIN", 64);
 
     // ===========================================
     //  DAY FUNCTIONS
     // ===========================================
     //FUNCTION_NAME[1][0] = "idk";
-    //writeFunc(kb->FUNCTION_NAME, 1, index, "idk", "idk", 64);
+    //writeFunc(schema->FUNCTION_NAME, 1, index, "idk", "idk", 64);
 
     // ===========================================
     //  METADATA FUNCTIONS
@@ -302,24 +377,24 @@ KnowledgeBase* initKB(const int NUM_PLAYERS)
     {
         for (int roleID = 0; roleID < NUM_BOTCT_ROLES; roleID++)
         {
-            writeRoleFunc(kb->FUNCTION_NAME, 2, index, ROLE_NAMES[roleID], "_in_PLAY", night, 64);
-            writeRoleFunc(kb->FUNCTION_NAME, 2, index, ROLE_NAMES[roleID], "_ALIVE", night, 64);
+            writeRoleFunc(schema->FUNCTION_NAME, 2, index, ROLE_NAMES[roleID], "_in_PLAY", night, 64);
+            writeRoleFunc(schema->FUNCTION_NAME, 2, index, ROLE_NAMES[roleID], "_ALIVE", night, 64);
         }
     }
     //FABELED
-    writeFunc(kb->FUNCTION_NAME, 2, index, "DOOMSLAYER_in_PLAY", "NOT_DOOMSLAYER_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "ANGEL_in_PLAY", "NOT_ANGEL_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "BUDDHIST_in_PLAY", "NOT_BUDDHIST_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "HELLS_LIBRARIAN_in_PLAY", "NOT_HELLS_LIBRARIAN_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "REVOLUTIONARY_in_PLAY", "NOT_REVOLUTIONARY_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "FIDDLER_in_PLAY", "NOT_FIDDLER_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "TOYMAKER_in_PLAY", "NOT_TOYMAKER_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "DOOMSLAYER_in_PLAY", "NOT_DOOMSLAYER_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "ANGEL_in_PLAY", "NOT_ANGEL_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "BUDDHIST_in_PLAY", "NOT_BUDDHIST_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "HELLS_LIBRARIAN_in_PLAY", "NOT_HELLS_LIBRARIAN_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "REVOLUTIONARY_in_PLAY", "NOT_REVOLUTIONARY_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "FIDDLER_in_PLAY", "NOT_FIDDLER_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "TOYMAKER_in_PLAY", "NOT_TOYMAKER_in_PLAY", 64);
     //CUSTOM
-    writeFunc(kb->FUNCTION_NAME, 2, index, "FIBBIN_in_PLAY", "NOT_FIBBIN_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "DUCHESS_in_PLAY", "NOT_DUCHESS_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "SENTINEL_in_PLAY", "NOT_SENTINEL_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "SPIRIT_OF_IVORY_in_PLAY", "NOT_SPIRIT_OF_IVORY_in_PLAY", 64);
-    writeFunc(kb->FUNCTION_NAME, 2, index, "DJINN_in_PLAY", "NOT_DJINN_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "FIBBIN_in_PLAY", "NOT_FIBBIN_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "DUCHESS_in_PLAY", "NOT_DUCHESS_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "SENTINEL_in_PLAY", "NOT_SENTINEL_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "SPIRIT_OF_IVORY_in_PLAY", "NOT_SPIRIT_OF_IVORY_in_PLAY", 64);
+    writeFunc(schema->FUNCTION_NAME, 2, index, "DJINN_in_PLAY", "NOT_DJINN_in_PLAY", 64);
 
     for (int i = 0; i < 3; i++)
     {
@@ -328,6 +403,10 @@ KnowledgeBase* initKB(const int NUM_PLAYERS)
             printf("KNOWLEDGE BASE TOO SMALL!");
             exit(1);
         }
+        //Only scan words that functions were written into
+        kb->SET_WORDS[i] = (index[i] + INT_LENGTH - 1) / INT_LENGTH;
+
+        buildFunctionNameHash(schema, i, index[i]);
     }
 
     return kb; //Return initilized knowledge base
@@ -336,12 +415,35 @@ KnowledgeBase* initKB(const int NUM_PLAYERS)
 /**
  * initProbKB() - allocate and initilise a probabalistic knowledge base structure
  * 
+ * @kb - the knowledge base the tally is for (only its set sizes and words are stored)
+ * 
  * @return the Probabilistic KB
 */
-ProbKnowledgeBase* initProbKB()
+ProbKnowledgeBase* initProbKB(KnowledgeBase* kb)
 {
     //Allocate memory
     ProbKnowledgeBase* tally = (ProbKnowledgeBase*) malloc(sizeof(ProbKnowledgeBase));
+    if (tally == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+
+    //Lay the rows of every set out one after another
+    tally->SIZE = 0;
+    for (int set = 0; set < NUM_SETS; set++)
+    {
+        tally->SET_OFFSETS[set] = tally->SIZE;
+        tally->SET_SIZES[set] = kb->SET_SIZES[set];
+        tally->SET_FUNCTIONS[set] = kb->SET_WORDS[set]*INT_LENGTH;
+        tally->SIZE += tally->SET_SIZES[set]*tally->SET_FUNCTIONS[set];
+    }
+    tally->VALUES = (ProbTallyValue*) malloc(tally->SIZE*sizeof(ProbTallyValue));
+    if (tally->VALUES == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
 
     resetProbKnowledgeBase(tally);
 
@@ -349,63 +451,43 @@ ProbKnowledgeBase* initProbKB()
 }
 
 /**
- * initCachedKB()
+ * freeProbKB() - free a probabalistic knowledge base
  * 
- * 
- */
-CachedKnowledgeBases* initCachedKB(KnowledgeBase* kb)
+ * @tally - the probabalistic knowledge base to free
+*/
+void freeProbKB(ProbKnowledgeBase* tally)
 {
-    //Allocate memory
-    CachedKnowledgeBases* cache = (CachedKnowledgeBases*) malloc(sizeof(CachedKnowledgeBases));
-
-    for (int i = 0; i < MAX_CACHED_WORLDS; i++)
-    {
-        cache->POSSIBLE_WORLDS_FOR_PROB[i] = initKBFromTemplate(kb);
-        cache->value[i] = NAN;
-    }
-
-
-    return cache;
+    free(tally->VALUES);
+    free(tally);
 }
 
 /**
- * addKBToCache()
- * 
+ * initKBTrail() - allocate an empty undo log
  * 
- */
-int addKBToCache(CachedKnowledgeBases* cache, KnowledgeBase* kb, double value)
+ * @return the trail
+*/
+KnowledgeBaseTrail* initKBTrail()
 {
-    for (int i = 0; i < MAX_CACHED_WORLDS; i++)
+    KnowledgeBaseTrail* trail = (KnowledgeBaseTrail*) malloc(sizeof(KnowledgeBaseTrail));
+    if (trail == NULL)
     {
-        if (isnan(cache->value[i]))
-        {
-            copyTo(cache->POSSIBLE_WORLDS_FOR_PROB[i], kb);
-            cache->value[i] = value;
-            return i;
-        }
+        printf("MALLOC FAILED!\n");
+        exit(1);
     }
-    return -1;
-}
-
-/**
- * resetProbKBWithCache()
- * 
- * 
- */
-void resetProbKBWithCache(ProbKnowledgeBase* tally, CachedKnowledgeBases* cache)
-{
-    resetProbKnowledgeBase(tally);
-    for (int i = 0; i < MAX_CACHED_WORLDS; i++)
+    trail->LENGTH = 0;
+    trail->CAPACITY = 1024;
+    trail->ENTRIES = (KnowledgeBaseTrailEntry*) malloc(trail->CAPACITY * sizeof(KnowledgeBaseTrailEntry));
+    if (trail->ENTRIES == NULL)
     {
-        if (isnan(cache->value[i]) == 0)
-        {
-            addKBtoProbTally(cache->POSSIBLE_WORLDS_FOR_PROB[i], tally, cache->value[i]);
-        }
+        printf("MALLOC FAILED!\n");
+        exit(1);
     }
+    return trail;
 }
 
 /**
- * copyTo() - deep copy (mostly) a knowledge base object
+ * copyTo() - copy the knowledge of a knowledge base object
+ * the schema is shared by reference
  * 
  * @dest - destination knowledge base
  * @src - source knowledge base
@@ -415,25 +497,9 @@ void copyTo(KnowledgeBase* dest, KnowledgeBase* src)
     //Deep copy knowlegde base (these might change)
     memcpy(dest->KNOWLEDGE_BASE, src->KNOWLEDGE_BASE, sizeof(long)*NUM_SETS*MAX_SET_ELEMENTS*FUNCTION_RESULT_SIZE);
     memcpy(dest->SET_SIZES, src->SET_SIZES, sizeof(int)*NUM_SETS);
-    for (int set = 0; set < NUM_SETS; set++)
-    {
-        //Shallow copy names (these will not change)
-        dest->SET_NAMES[set] = src->SET_NAMES[set];
-        //strcpy(dest->SET_NAMES[i], src->SET_NAMES[i]); //Deep copy version
-
-        for (int element = 0; element < MAX_SET_ELEMENTS; element++)
-        {
-            //Shallow copy names (these will not change)
-            dest->ELEMENT_NAMES[set][element] = src->ELEMENT_NAMES[set][element];
-        }
-
-        for (int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
-        {
-            //Shallow copy names (these will not change)
-            dest->FUNCTION_NAME[set][function] = src->FUNCTION_NAME[set][function];
-           //strcpy(dest->FUNCTION_NAME[i][j], src->FUNCTION_NAME[i][j]); //Deep copy version
-        }
-    }
+    memcpy(dest->SET_WORDS, src->SET_WORDS, sizeof(int)*NUM_SETS);
+    //Share names (these will not change)
+    dest->SCHEMA = src->SCHEMA;
 }
 
 /**
@@ -449,7 +515,7 @@ int getSetIDWithName(KnowledgeBase* kb, char* set, int validate)
 {
     for (int i = 0; i < NUM_SETS; i++)
     {
-        if (strcmp(set,kb->SET_NAMES[i]) == 0)
+        if (strcmp(set,kb->SCHEMA->SET_NAMES[i]) == 0)
         {
             return i;
         }
@@ -474,20 +540,23 @@ int getSetIDWithName(KnowledgeBase* kb, char* set, int validate)
 */
 int getSetFunctionIDWithName(KnowledgeBase* kb, int setID, char* function, int validate)
 {
-    for (int i = 0; i < FUNCTION_RESULT_SIZE*INT_LENGTH; i++)
+    int slot = hashFunctionName(function);
+    while (kb->SCHEMA->FUNCTION_NAME_HASH[setID][slot] != 0)
     {
+        int i = kb->SCHEMA->FUNCTION_NAME_HASH[setID][slot]-1;
         //printf("COMPARE: %s, %s\n",function,FUNCTION_NAME[setID][i]);
-        if (strcmp(function,kb->FUNCTION_NAME[setID][i]) == 0)
+        if (strcmp(function,kb->SCHEMA->FUNCTION_NAME[setID][i]) == 0)
         {
             return i;
         }
+        slot = (slot + 1) & (FUNCTION_NAME_HASH_SIZE-1);
     }
     if (validate == 1)
     {
         printf("ERROR: WRONG FUNCTION (set='%d') NAME '%s' set contains=\n", setID, function);
         for (int i = 0; i < FUNCTION_RESULT_SIZE*INT_LENGTH; i++)
         {
-            printf("%s,\n",kb->FUNCTION_NAME[setID][i]);
+            printf("%s,\n",kb->SCHEMA->FUNCTION_NAME[setID][i]);
         }
         exit(1);
     }
@@ -509,7 +578,7 @@ int getSetElementIDWithName(KnowledgeBase* kb, int setID, char* element, int val
     for (int i = 0; i < MAX_SET_ELEMENTS; i++)
     {
         //printf("COMPARE: %s, %s\n",function,FUNCTION_NAME[setID][i]);
-        if (strcmp(element,kb->ELEMENT_NAMES[setID][i]) == 0)
+        if (strcmp(element,kb->SCHEMA->ELEMENT_NAMES[setID][i]) == 0)
         {
             return i;
         }
@@ -519,7 +588,7 @@ int getSetElementIDWithName(KnowledgeBase* kb, int setID, char* element, int val
         printf("ERROR: WRONG ELEMENT (set='%d') NAME '%s' set contains=\n", setID, element);
         for (int i = 0; i < MAX_SET_ELEMENTS; i++)
         {
-            printf("%s,\n",kb->ELEMENT_NAMES[setID][i]);
+            printf("%s,\n",kb->SCHEMA->ELEMENT_NAMES[setID][i]);
         }
         exit(1);
     }
@@ -539,6 +608,62 @@ void getIndexAndBit(int* index, int* bit, int functionID)
     *bit = functionID - (*index * INT_LENGTH);
 }
 
+/**
+ * recordKnowledgeWord() - record the value of a word before it is changed
+ * does nothing if the knowledge base has no trail
+ * 
+ * @kb - the knowledge base the word belongs to
+ * @word - the word about to be changed
+*/
+void recordKnowledgeWord(KnowledgeBase* kb, long* word)
+{
+    KnowledgeBaseTrail* trail = kb->TRAIL;
+    if (trail == NULL) return;
+
+    if (trail->LENGTH >= trail->CAPACITY)
+    {
+        trail->CAPACITY *= 2;
+        trail->ENTRIES = (KnowledgeBaseTrailEntry*) realloc(trail->ENTRIES, trail->CAPACITY * sizeof(KnowledgeBaseTrailEntry));
+        if (trail->ENTRIES == NULL)
+        {
+            printf("MALLOC FAILED!\n");
+            exit(1);
+        }
+    }
+    trail->ENTRIES[trail->LENGTH].WORD = word;
+    trail->ENTRIES[trail->LENGTH].VALUE = *word;
+    trail->LENGTH++;
+}
+
+/**
+ * getTrailMark() - get a mark to later undo back to
+ * 
+ * @kb - the knowledge base (must have a trail)
+ * 
+ * @return the current length of the trail
+*/
+int getTrailMark(KnowledgeBase* kb)
+{
+    return kb->TRAIL->LENGTH;
+}
+
+/**
+ * undoTrail() - revert every word changed since the mark was taken
+ * 
+ * @kb - the knowledge base to revert (must have a trail)
+ * @mark - mark from getTrailMark()
+*/
+void undoTrail(KnowledgeBase* kb, int mark)
+{
+    KnowledgeBaseTrail* trail = kb->TRAIL;
+    //Undo newest first so a word changed twice ends at its oldest value
+    while (trail->LENGTH > mark)
+    {
+        trail->LENGTH--;
+        *(trail->ENTRIES[trail->LENGTH].WORD) = trail->ENTRIES[trail->LENGTH].VALUE;
+    }
+}
+
 /**
  * resetKnowledgeBase() - reset the knowledge in the knowledge base
  * 
@@ -565,17 +690,9 @@ void resetKnowledgeBase(KnowledgeBase* kb)
 */
 void resetProbKnowledgeBase(ProbKnowledgeBase* tally)
 {
-    for (int set = 0; set < NUM_SETS; set++)
-    {
-        for (int element = 0; element < MAX_SET_ELEMENTS; element++)
-        {
-            for (int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
-            {
-                tally->KNOWLEDGE_BASE[set][element][function] = 0.0;
-            }
-        }
-    }
+    memset(tally->VALUES, 0, tally->SIZE*sizeof(ProbTallyValue));
     tally->tally = 0.0;
+    tally->numWorlds = 0;
 }
 
 /**
@@ -600,14 +717,32 @@ void resetElement(KnowledgeBase* kb, int set, int element)
  * @x - the extra knowledge to add into kb (inline)
 */
 void mergeKnowledge(KnowledgeBase* kb, KnowledgeBase* x)
+{
+    for (int set = 0; set < NUM_SETS; set++)
+    {
+        mergeRows(kb->KNOWLEDGE_BASE[set][0], x->KNOWLEDGE_BASE[set][0], kb->SET_SIZES[set], kb->SET_WORDS[set]);
+    }
+}
+
+/**
+ * mergeKnowledgeTracked() - mergeKnowledge() that also marks the words it changed
+ * 
+ * @kb - the knowledge base to merge into
+ * @x - the extra knowledge to add into kb (inline)
+ * @changedWords - OUTPUTS bitmask for each set of the word indexes that gained knowledge
+*/
+void mergeKnowledgeTracked(KnowledgeBase* kb, KnowledgeBase* x, long changedWords[NUM_SETS])
 {
     for (int set = 0; set < NUM_SETS; set++)
     {
         for (int element = 0; element < kb->SET_SIZES[set]; element++)
         {
-            for (int i = 0 ; i < FUNCTION_RESULT_SIZE; i++)
+            for (int i = 0; i < kb->SET_WORDS[set]; i++)
             {
-                kb->KNOWLEDGE_BASE[set][element][i] |= x->KNOWLEDGE_BASE[set][element][i];
+                long merged = kb->KNOWLEDGE_BASE[set][element][i] | x->KNOWLEDGE_BASE[set][element][i];
+                if (merged == kb->KNOWLEDGE_BASE[set][element][i]) continue;
+                kb->KNOWLEDGE_BASE[set][element][i] = merged;
+                changedWords[set] |= 1L << i;
             }
         }
     }
@@ -621,17 +756,13 @@ void mergeKnowledge(KnowledgeBase* kb, KnowledgeBase* x)
 */
 void mergeProbKnowledge(ProbKnowledgeBase* probkb, ProbKnowledgeBase* x)
 {
-    for (int set = 0; set < NUM_SETS; set++)
+    //Both tallies were made for the same game so have the same layout
+    for (int i = 0; i < probkb->SIZE; i++)
     {
-        for (int element = 0; element < MAX_SET_ELEMENTS; element++)
-        {
-            for (int function = 0 ; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
-            {
-                probkb->KNOWLEDGE_BASE[set][element][function] += x->KNOWLEDGE_BASE[set][element][function];
-            }
-        }
+        probkb->VALUES[i] += x->VALUES[i];
     }
     probkb->tally += x->tally;
+    probkb->numWorlds += x->numWorlds;
 }
 
 /**
@@ -649,6 +780,7 @@ void addKnowledge(KnowledgeBase* kb, int set, int element, int function)
 
     long mask = 1L << bit;
 
+    if ((kb->KNOWLEDGE_BASE[set][element][index] & mask) == 0) recordKnowledgeWord(kb, &kb->KNOWLEDGE_BASE[set][element][index]);
     kb->KNOWLEDGE_BASE[set][element][index] |= mask;
 }
 
@@ -718,29 +850,48 @@ int hasExplicitContradiction(KnowledgeBase* kb)
     //Don't ask... you really REALLY don't wanna know
     //just think it's magic
     
-    //Declare bitstring masks to store find TRUE FALSE statements in resulting bitstrings
-    const long ODD_MASK = 6148914691236517205;
-    //const long EVEN_MASK = -6148914691236517206; //Can remove due to note
+    //With bitstring masks find TRUE FALSE statements in resulting bitstrings
+    //ODD_MASK = 6148914691236517205
+    //EVEN_MASK = -6148914691236517206 //Can remove due to note
+
+    //NOTE: thanks to J Hearn I have removed the even mask making this code even more insanely diabolical
+    //YAY!
+    //FT   FT FT
+    //0F   0F 0F
+    //FT   FT FT
+    //0F&T... 
+    //oddBitString = bitString & ODD_MASK; //All true statements
+    //Finding contradictions using magic bitstrings
+    //if ((oddBitString << 1) & bitString) return 1; //If true and false
+
+    //NOTE: the kernels run this on a whole vector of words at a time (see bitset.c)
+    for (int set = 0; set < NUM_SETS; set++)
+    {
+        if (hasContradictionInRows(kb->KNOWLEDGE_BASE[set][0], kb->SET_SIZES[set], kb->SET_WORDS[set])) return 1;
+    }
+    return 0;
+}
 
+/**
+ * hasContradictionInChangedWords() - hasExplicitContradiction() only checking some words of every element
+ * 
+ * @kb - the knowledge base to check
+ * @changedWords - bitmask for each set of the word indexes to check
+ * 
+ * @return TRUE (1) if there is a contradiction in the words
+*/
+int hasContradictionInChangedWords(KnowledgeBase* kb, long changedWords[NUM_SETS])
+{
     for (int set = 0; set < NUM_SETS; set++)
     {
-        for (int element = 0; element < MAX_SET_ELEMENTS; element++)
+        unsigned long words = changedWords[set];
+        while (words != 0)
         {
-            for (int index = 0; index < FUNCTION_RESULT_SIZE; index++)
+            int index = __builtin_ctzl(words);
+            words &= words - 1;
+            for (int element = 0; element < kb->SET_SIZES[set]; element++)
             {
-                long bitString = kb->KNOWLEDGE_BASE[set][element][index];
-                
-                //NOTE: thanks to J Hearn I have removed the even mask making this code even more insanely diabolical
-                //YAY!
-                //FT   FT FT
-                //0F   0F 0F
-                //FT   FT FT
-                //0F&T... 
-                long oddBitString = bitString & ODD_MASK; //All true statements
-                //long evenBitString = bitString & EVEN_MASK; //All false statements
-                //Finding contradictions using magic bitstrings
-                //NOTE: loop unrolling with branchless statements might make this the final boss of micro optimisations
-                if ((oddBitString << 1) & bitString) return 1; //If true and false
+                if (hasContradictionInWord(kb->KNOWLEDGE_BASE[set][element][index])) return 1;
             }
         }
     }
@@ -756,22 +907,42 @@ int hasExplicitContradiction(KnowledgeBase* kb)
 */
 void addKBtoProbTally(KnowledgeBase* kb, ProbKnowledgeBase* tally, double weight)
 {
-
     for (int set = 0; set < NUM_SETS; set++)
     {
-        for (int element = 0; element < MAX_SET_ELEMENTS; element++)
+        for (int element = 0; element < kb->SET_SIZES[set]; element++)
         {
-            for(int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
+            for (int index = 0; index < kb->SET_WORDS[set]; index++)
             {
-                if (isKnown(kb, set, element, function))
+                //Only walk the functions which are true, lowest bit first
+                unsigned long bitString = kb->KNOWLEDGE_BASE[set][element][index];
+                ProbTallyValue* functionTally = &tally->VALUES[tally->SET_OFFSETS[set] + element*tally->SET_FUNCTIONS[set] + index*INT_LENGTH];
+                while (bitString != 0)
                 {
-                    tally->KNOWLEDGE_BASE[set][element][function] += weight;
+                    functionTally[__builtin_ctzl(bitString)] += weight;
+                    bitString &= bitString - 1;
                 }
             }
         }
     }
     tally->tally += weight;
+    tally->numWorlds++;
+}
+/**
+ * getProbTally() - get the weighted tally of worlds where a function is true
+ * 
+ * @tally - the probablistic knowledge base
+ * @set - the setID/index of the element
+ * @element - the elementID/index
+ * @function - the functionID/index
+ * 
+ * @return the tally (0 for elements or functions not stored)
+*/
+double getProbTally(ProbKnowledgeBase* tally, int set, int element, int function)
+{
+    if (element >= tally->SET_SIZES[set] || function >= tally->SET_FUNCTIONS[set]) return 0.0;
+    return tally->VALUES[tally->SET_OFFSETS[set] + element*tally->SET_FUNCTIONS[set] + function];
 }
+
 //Used to accomodate for floating point rounding
 #define EPSILON 1.0
 /**
@@ -786,7 +957,7 @@ void addKBtoProbTally(KnowledgeBase* kb, ProbKnowledgeBase* tally, double weight
 */
 int getProbIntPercentage(ProbKnowledgeBase* tally, int set, int element, int function)
 {
-    double percentage = (tally->KNOWLEDGE_BASE[set][element][function]*100.0) / tally->tally;
+    double percentage = (getProbTally(tally, set, element, function)*100.0) / tally->tally;
 
     //Floating point rounding correction
     if (percentage > 100.0 - EPSILON) return 100;
@@ -828,9 +999,9 @@ double getShannonEntropy(ProbKnowledgeBase* tally, KnowledgeBase* kb, int set)
     double entropy = 0;
     for (int element = 0; element < kb->SET_SIZES[set]; element++)
     {
-        for (int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
+        for (int function = 0; function < tally->SET_FUNCTIONS[set]; function++)
         {
-            double prob = tally->KNOWLEDGE_BASE[set][element][function] / tally->tally;
+            double prob = getProbTally(tally, set, element, function) / tally->tally;
 
             if (prob > 0.001) entropy -= prob * log2(prob); //Stop funny log 0 errors
         }
@@ -854,7 +1025,7 @@ void printKnowledgeBase(KnowledgeBase* kb)
             {
                 if (isKnown(kb, set, element, function))
                 {
-                    printf("%s(%d:%s), ", kb->FUNCTION_NAME[set][function], element, kb->SET_NAMES[set]);
+                    printf("%s(%d:%s), ", kb->SCHEMA->FUNCTION_NAME[set][function], element, kb->SCHEMA->SET_NAMES[set]);
                 }
             }
             printf("\n");
@@ -949,7 +1120,7 @@ void printPlayerTable(KnowledgeBase* kb, int night)
         snprintf(buff, 64, "is_DEAD_[NIGHT%d]", night);
         int isDead = isKnownName(kb, "PLAYERS", element, buff); 
 
-        printTrucatedStr(kb->ELEMENT_NAMES[0][element], 9);
+        printTrucatedStr(kb->SCHEMA->ELEMENT_NAMES[0][element], 9);
         printf("|");
         for (int role = 0; role < NUM_BOTCT_ROLES; role++)
         {
@@ -1215,7 +1386,7 @@ void printProbPlayerTable(KnowledgeBase* kb, ProbKnowledgeBase* probkb, int nigh
     {
 
 
-        printTrucatedStr(kb->ELEMENT_NAMES[0][element], 9);
+        printTrucatedStr(kb->SCHEMA->ELEMENT_NAMES[0][element], 9);
         printf("|");
         for (int role = 0; role < NUM_BOTCT_ROLES; role++)
         {
@@ -26,26 +26,76 @@
 
 #include "constants.h"
 
+//Must be a power of 2 and larger than FUNCTION_RESULT_SIZE*INT_LENGTH
+#define FUNCTION_NAME_HASH_SIZE (4*FUNCTION_RESULT_SIZE*INT_LENGTH)
+
+//A function of an element of a set as a single number, functions come in pairs so a literal^1 is its negation
+#define FUNCTIONS_PER_ELEMENT (FUNCTION_RESULT_SIZE*INT_LENGTH)
+#define NUM_FUNCTION_LITERALS (NUM_SETS*MAX_SET_ELEMENTS*FUNCTIONS_PER_ELEMENT)
+#define FUNCTION_LITERAL(set, element, function) (((set)*MAX_SET_ELEMENTS + (element))*FUNCTIONS_PER_ELEMENT + (function))
+#define LITERAL_SET(literal) ((literal) / (MAX_SET_ELEMENTS*FUNCTIONS_PER_ELEMENT))
+#define LITERAL_ELEMENT(literal) (((literal) / FUNCTIONS_PER_ELEMENT) % MAX_SET_ELEMENTS)
+#define LITERAL_FUNCTION(literal) ((literal) % FUNCTIONS_PER_ELEMENT)
+
 /************************************************************
  * Knowledge base Structures
  ************************************************************/
 typedef struct {
-    long KNOWLEDGE_BASE[NUM_SETS][MAX_SET_ELEMENTS][FUNCTION_RESULT_SIZE];
-    int SET_SIZES[NUM_SETS];
+    long* WORD;
+    long VALUE;
+} KnowledgeBaseTrailEntry;
 
+/*
+ * Undo log of the words changed in a knowledge base, used for backtracking
+*/
+typedef struct {
+    KnowledgeBaseTrailEntry* ENTRIES;
+    int LENGTH;
+    int CAPACITY;
+} KnowledgeBaseTrail;
+
+/*
+ * Names of the sets, elements and functions
+ * one schema is shared by reference between every knowledge base of a game
+*/
+typedef struct {
     char *FUNCTION_NAME[NUM_SETS][FUNCTION_RESULT_SIZE*INT_LENGTH];
     char *SET_NAMES[NUM_SETS];
     char *ELEMENT_NAMES[NUM_SETS][MAX_SET_ELEMENTS];
-} KnowledgeBase;
+
+    //Open addressing hash table of functionID+1 (0 if empty) for looking up functions by name
+    int FUNCTION_NAME_HASH[NUM_SETS][FUNCTION_NAME_HASH_SIZE];
+} KnowledgeBaseSchema;
 
 typedef struct {
-    KnowledgeBase* POSSIBLE_WORLDS_FOR_PROB[MAX_CACHED_WORLDS];
-    double value[MAX_CACHED_WORLDS];
-} CachedKnowledgeBases;
+    long KNOWLEDGE_BASE[NUM_SETS][MAX_SET_ELEMENTS][FUNCTION_RESULT_SIZE];
+    int SET_SIZES[NUM_SETS];
+    int SET_WORDS[NUM_SETS]; //Number of words per element that hold functions
+
+    KnowledgeBaseTrail* TRAIL; //NULL if changes are not being recorded
+
+    KnowledgeBaseSchema* SCHEMA; //Shared, never copied
+} KnowledgeBase;
 
+//Build with -DPROB_TALLY_FLOAT to tally in single precision (half the memory but less accurate)
+#ifdef PROB_TALLY_FLOAT
+typedef float ProbTallyValue;
+#else
+typedef double ProbTallyValue;
+#endif
+
+/*
+ * Weighted tally of the functions that are true in sampled worlds
+ * only the elements and function words used by the knowledge base it was made for are stored
+*/
 typedef struct {
-    double KNOWLEDGE_BASE[NUM_SETS][MAX_SET_ELEMENTS][FUNCTION_RESULT_SIZE*INT_LENGTH];
+    ProbTallyValue* VALUES; //A row of SET_FUNCTIONS[set] values for each element of each set
+    int SET_OFFSETS[NUM_SETS]; //Index of the first row of each set in VALUES
+    int SET_SIZES[NUM_SETS];
+    int SET_FUNCTIONS[NUM_SETS];
+    int SIZE; //Number of values
     double tally;
+    long numWorlds; //Number of worlds added into the tally
 } ProbKnowledgeBase;
 
 /************************************************************
@@ -70,29 +120,69 @@ KnowledgeBase* initKBFromTemplate(KnowledgeBase* template);
 /**
  * initProbKB() - allocate and initilise a probabalistic knowledge base structure
  * 
+ * @kb - the knowledge base the tally is for (only its set sizes and words are stored)
+ * 
  * @return the Probabilistic KB
 */
-ProbKnowledgeBase* initProbKB();
+ProbKnowledgeBase* initProbKB(KnowledgeBase* kb);
 
 /**
- * initCachedKB()
+ * initKBTrail() - allocate an empty undo log
  * 
+ * @return the trail
+*/
+KnowledgeBaseTrail* initKBTrail();
+
+/**
+ * freeProbKB() - free a probabalistic knowledge base
  * 
- */
-CachedKnowledgeBases* initCachedKB(KnowledgeBase* kb);
+ * @tally - the probabalistic knowledge base to free
+*/
+void freeProbKB(ProbKnowledgeBase* tally);
 
 /************************************************************
  * Copying Functions
  ************************************************************/
 
 /**
- * copyTo() - deep copy (mostly) a knowledge base object
+ * copyTo() - copy the knowledge of a knowledge base object
+ * the schema is shared by reference
  * 
  * @dest - destination knowledge base
  * @src - source knowledge base
 */
 void copyTo(KnowledgeBase* dest, KnowledgeBase* src);
 
+/************************************************************
+ * Backtracking Functions
+ ************************************************************/
+
+/**
+ * recordKnowledgeWord() - record the value of a word before it is changed
+ * does nothing if the knowledge base has no trail
+ * 
+ * @kb - the knowledge base the word belongs to
+ * @word - the word about to be changed
+*/
+void recordKnowledgeWord(KnowledgeBase* kb, long* word);
+
+/**
+ * getTrailMark() - get a mark to later undo back to
+ * 
+ * @kb - the knowledge base (must have a trail)
+ * 
+ * @return the current length of the trail
+*/
+int getTrailMark(KnowledgeBase* kb);
+
+/**
+ * undoTrail() - revert every word changed since the mark was taken
+ * 
+ * @kb - the knowledge base to revert (must have a trail)
+ * @mark - mark from getTrailMark()
+*/
+void undoTrail(KnowledgeBase* kb, int mark);
+
 /************************************************************
  * Reset Functions
  ************************************************************/
@@ -178,6 +268,15 @@ void resetElement(KnowledgeBase* kb, int set, int element);
 */
 void mergeKnowledge(KnowledgeBase* kb, KnowledgeBase* x);
 
+/**
+ * mergeKnowledgeTracked() - mergeKnowledge() that also marks the words it changed
+ * 
+ * @kb - the knowledge base to merge into
+ * @x - the extra knowledge to add into kb (inline)
+ * @changedWords - OUTPUTS bitmask for each set of the word indexes that gained knowledge
+*/
+void mergeKnowledgeTracked(KnowledgeBase* kb, KnowledgeBase* x, long changedWords[NUM_SETS]);
+
 /**
  * mergeProbKnowledge() - merge the probabalistic knowledge from 2 different bases into 1 (inline)
  * 
@@ -245,6 +344,16 @@ int isKnownName(KnowledgeBase* kb,  char* set, int element, char* function);
 */
 int hasExplicitContradiction(KnowledgeBase* kb);
 
+/**
+ * hasContradictionInChangedWords() - hasExplicitContradiction() only checking some words of every element
+ * 
+ * @kb - the knowledge base to check
+ * @changedWords - bitmask for each set of the word indexes to check
+ * 
+ * @return TRUE (1) if there is a contradiction in the words
+*/
+int hasContradictionInChangedWords(KnowledgeBase* kb, long changedWords[NUM_SETS]);
+
 /************************************************************
  * Tally Functions
  ************************************************************/
@@ -269,6 +378,18 @@ void addKBtoProbTally(KnowledgeBase* kb, ProbKnowledgeBase* tally, double weight
 */
 int getProbIntPercentage(ProbKnowledgeBase* tally, int set, int element, int function);
 
+/**
+ * getProbTally() - get the weighted tally of worlds where a function is true
+ * 
+ * @tally - the probablistic knowledge base
+ * @set - the setID/index of the element
+ * @element - the elementID/index
+ * @function - the functionID/index
+ * 
+ * @return the tally (0 for elements or functions not stored)
+*/
+double getProbTally(ProbKnowledgeBase* tally, int set, int element, int function);
+
 /**
  * getProbIntPercentage() - get an estimation for the probability of somethign being true in the tally
  * 
@@ -293,22 +414,6 @@ int getProbIntPercentageName(ProbKnowledgeBase* tally, KnowledgeBase* kb, char*
 double getShannonEntropy(ProbKnowledgeBase* tally, KnowledgeBase* kb, int set);
 
 
-/************************************************************
- * Cache Functions
- ************************************************************/
-/**
- * addKBToCache()
- * 
- * 
- */
-int addKBToCache(CachedKnowledgeBases* cache, KnowledgeBase* kb, double value);
-
-/**
- * resetProbKBWithCache()
- * 
- * 
- */
-void resetProbKBWithCache(ProbKnowledgeBase* tally, CachedKnowledgeBases* cache);
 
 /**
  * printKnowledgeBase() - print the knowledge base to the terminal
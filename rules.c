@@ -28,6 +28,7 @@
 
 #include "rules.h"
 #include "knowledge.h"
+#include "bitset.h"
 #include "constants.h"
 
 /**
@@ -48,11 +49,11 @@ int getNumRules(RuleSet* ruleSet)
  * @ruleSet - the ruleset which stores the rules
  * @index - the location of the rule to get
  * 
- * @return the rule at index
+ * @return the rule at index (only valid until the next rule is pushed)
 */
 Rule* getRule(RuleSet* ruleSet, int index)
 {
-    return ruleSet->RULES[index];
+    return (Rule*) (ruleSet->RULE_ARENA + ruleSet->RULE_OFFSETS[index]);
 }
 
 /**
@@ -60,12 +61,23 @@ Rule* getRule(RuleSet* ruleSet, int index)
  * 
  * @rule - the rule to reset
 */
-static void resetRule(Rule* rule)
+static void resetRule(TempRule* rule)
 {
     rule->varCount = 0;
     rule->resultVarName = 0;
     rule->resultFromSet = 0;
     rule->LHSSymmetric = 0;
+    rule->minCount = 0;
+    rule->maxCount = 0;
+    rule->numCounted = 0;
+    rule->countedFromSet = 0;
+    if (rule->numParamValues > 0)
+    { //Only templates write to the parametric words
+        memset(rule->paramWords, 0, sizeof(rule->paramWords));
+        memset(rule->paramMissing, 0, sizeof(rule->paramMissing));
+    }
+    rule->numParamValues = 0;
+    rule->paramVar = -1;
     for (int i = 0; i < MAX_VARS_IN_RULE; i++)
     {
         rule->varConditionFromSet[i] = 0;
@@ -94,8 +106,25 @@ static void resetRule(Rule* rule)
  * 
  * @return TRUE if the left hand side of the rule impication is identical across all variables
 */
-static int LHSSymmetric(Rule* rule)
+static int LHSSymmetric(TempRule* rule)
 {
+    //A template is only symmetric if every var has the same parametric conditions for each value
+    //(the var the parameter is substituted into is forced to a different element from the rest)
+    if (rule->numParamValues > 0)
+    {
+        if (rule->paramVar != -1) return 0;
+        for (int value = 0; value < rule->numParamValues; value++)
+        {
+            for (int var = 1; var < rule->varCount; var++)
+            {
+                for (int i = 0; i < FUNCTION_RESULT_SIZE; i++)
+                {
+                    if (rule->paramWords[value][0][i] != rule->paramWords[value][var][i]) return 0;
+                }
+            }
+        }
+    }
+
     //Check LHS Symmetric
     for (int var = 1; var < rule->varCount; var++)
     {
@@ -118,9 +147,224 @@ static int LHSSymmetric(Rule* rule)
     return 1;
 }
 
+/**
+ * addRuleWatchers() - register a rule as watching every (set, word) its LHS conditions read
+ * a template only needs checking for the values whose parametric words changed, unless a static word changed
+ * 
+ * @ruleSet - the ruleset to index the rule in
+ * @rule - the rule to index
+ * @ruleID - the index the rule is stored at
+*/
+static void addRuleWatchers(RuleSet* ruleSet, Rule* rule, int ruleID)
+{
+    //Collect the words read by each set so a rule is only added once per word
+    long watchedWords[NUM_SETS] = {0};
+    unsigned int watchedValues[NUM_SETS][FUNCTION_RESULT_SIZE] = {{0}};
+    for (int var = 0; var < rule->varCount; var++)
+    {
+        for (int i = rule->varConditionStart[var]; i < rule->varConditionStart[var+1]; i++)
+        {
+            watchedWords[rule->varConditionFromSet[var]] |= 1L << rule->words[i].index;
+            watchedValues[rule->varConditionFromSet[var]][rule->words[i].index] = ALL_PARAM_VALUES;
+        }
+    }
+    for (int i = rule->countedStart; i < rule->countedStart + 2*rule->numCounted; i++)
+    {
+        watchedWords[rule->countedFromSet] |= 1L << (rule->words[i].index % FUNCTION_RESULT_SIZE);
+        watchedValues[rule->countedFromSet][rule->words[i].index % FUNCTION_RESULT_SIZE] = ALL_PARAM_VALUES;
+    }
+    for (int value = 0; value < rule->numParamValues; value++)
+    {
+        for (int i = rule->words[rule->paramStart + value].index; i < rule->words[rule->paramStart + value + 1].index; i++)
+        {
+            int slot = rule->words[i].index / FUNCTION_RESULT_SIZE;
+            if (slot >= MAX_VARS_IN_RULE) continue; //Results aren't read
+            int set = rule->varConditionFromSet[slot];
+            int word = rule->words[i].index % FUNCTION_RESULT_SIZE;
+            watchedWords[set] |= 1L << word;
+            watchedValues[set][word] |= 1U << value;
+        }
+    }
+    for (int set = 0; set < NUM_SETS; set++)
+    {
+        for (int i = 0; i < FUNCTION_RESULT_SIZE; i++)
+        {
+            if (((watchedWords[set] >> i) & 1) == 0) continue;
+
+            if (ruleSet->NUM_WATCHERS[set][i] == ruleSet->WATCHERS_CAPACITY[set][i])
+            { //Grow the list
+                int capacity = ruleSet->WATCHERS_CAPACITY[set][i] == 0 ? 64 : ruleSet->WATCHERS_CAPACITY[set][i]*2;
+                int* watchers = (int*) realloc(ruleSet->WATCHERS[set][i], capacity*sizeof(int));
+                unsigned int* values = (unsigned int*) realloc(ruleSet->WATCHER_VALUES[set][i], capacity*sizeof(unsigned int));
+                if (watchers == NULL || values == NULL)
+                {
+                    printf("MALLOC FAILED!\n");
+                    exit(1);
+                }
+                ruleSet->WATCHERS[set][i] = watchers;
+                ruleSet->WATCHER_VALUES[set][i] = values;
+                ruleSet->WATCHERS_CAPACITY[set][i] = capacity;
+            }
+            ruleSet->WATCHERS[set][i][ruleSet->NUM_WATCHERS[set][i]] = ruleID;
+            ruleSet->WATCHER_VALUES[set][i][ruleSet->NUM_WATCHERS[set][i]] = watchedValues[set][i];
+            ruleSet->NUM_WATCHERS[set][i]++;
+        }
+    }
+}
+
+/**
+ * addRuleWords() - append the non-zero words of a bitstring to a compiled rule
+ * 
+ * @rule - the compiled rule to append to
+ * @bitString - the words to append
+*/
+static void addRuleWords(Rule* rule, long bitString[FUNCTION_RESULT_SIZE])
+{
+    for (int i = 0; i < FUNCTION_RESULT_SIZE; i++)
+    {
+        if (bitString[i] == 0) continue;
+        rule->words[rule->numWords].index = i;
+        rule->words[rule->numWords].mask = bitString[i];
+        rule->numWords++;
+    }
+}
+
+/**
+ * getCompiledRuleSize() - get the number of bytes a temp rule takes once compiled
+ * 
+ * @tempRule - the temp rule to compile
+ * 
+ * @return the size of the compiled rule
+*/
+static long getCompiledRuleSize(TempRule* tempRule)
+{
+    int numWords = 0;
+    for (int var = 0; var < tempRule->varCount; var++)
+    {
+        for (int i = 0; i < FUNCTION_RESULT_SIZE; i++) numWords += tempRule->varConditions[var][i] != 0;
+    }
+    for (int i = 0; i < FUNCTION_RESULT_SIZE; i++) numWords += tempRule->result[i] != 0;
+    numWords += 2*tempRule->numCounted;
+    if (tempRule->numParamValues > 0)
+    { //The table of where each value starts then the words of every value with an instance
+        numWords += tempRule->numParamValues + 1;
+        for (int value = 0; value < tempRule->numParamValues; value++)
+        {
+            if (tempRule->paramMissing[value]) continue;
+            for (int slot = 0; slot < PARAM_SLOTS; slot++)
+            {
+                for (int i = 0; i < FUNCTION_RESULT_SIZE; i++) numWords += tempRule->paramWords[value][slot][i] != 0;
+            }
+        }
+    }
+
+    return sizeof(Rule) + numWords*sizeof(RuleWord);
+}
+
+/**
+ * compileRule() - compile a temp rule into a rule storing only its non-zero words
+ * 
+ * @tempRule - the temp rule to compile
+ * @rule - OUTPUT memory of getCompiledRuleSize() bytes to compile into
+*/
+static void compileRule(TempRule* tempRule, Rule* rule)
+{
+    rule->varsMutuallyExclusive = tempRule->varsMutuallyExclusive;
+    rule->varCount = tempRule->varCount;
+    rule->resultVarName = tempRule->resultVarName;
+    rule->resultFromSet = tempRule->resultFromSet;
+    rule->LHSSymmetric = tempRule->LHSSymmetric;
+    rule->minCount = tempRule->minCount;
+    rule->maxCount = tempRule->maxCount;
+    rule->numCounted = tempRule->numCounted;
+    rule->countedFromSet = tempRule->countedFromSet;
+    rule->numParamValues = tempRule->numParamValues;
+    rule->paramVar = tempRule->paramVar;
+    rule->numWords = 0;
+    for (int var = 0; var < MAX_VARS_IN_RULE; var++)
+    {
+        rule->varConditionStart[var] = rule->numWords;
+        rule->varConditionFromSet[var] = tempRule->varConditionFromSet[var];
+        rule->varsForcedSubstitutions[var] = tempRule->varsForcedSubstitutions[var];
+        if (var < tempRule->varCount) addRuleWords(rule, tempRule->varConditions[var]);
+    }
+    rule->varConditionStart[MAX_VARS_IN_RULE] = rule->numWords;
+    rule->countedStart = rule->numWords;
+    for (int i = 0; i < tempRule->numCounted; i++)
+    {
+        int functions[2] = {tempRule->countedFunctions[i], tempRule->countedNotFunctions[i]};
+        for (int j = 0; j < 2; j++)
+        {
+            int index, bit;
+            getIndexAndBit(&index, &bit, functions[j]);
+            rule->words[rule->numWords].index = tempRule->countedElements[i]*FUNCTION_RESULT_SIZE + index;
+            rule->words[rule->numWords].mask = 1L << bit;
+            rule->numWords++;
+        }
+    }
+    rule->paramStart = rule->numWords;
+    rule->paramOtherResults = 0;
+    if (tempRule->numParamValues > 0)
+    {
+        RuleWord* table = &rule->words[rule->paramStart];
+        rule->numWords += tempRule->numParamValues + 1;
+        for (int value = 0; value < tempRule->numParamValues; value++)
+        {
+            table[value].index = rule->numWords;
+            table[value].mask = !tempRule->paramMissing[value];
+            if (tempRule->paramMissing[value]) continue;
+            for (int slot = 0; slot < PARAM_SLOTS; slot++)
+            {
+                int start = rule->numWords;
+                addRuleWords(rule, tempRule->paramWords[value][slot]);
+                for (int i = start; i < rule->numWords; i++) rule->words[i].index += slot*FUNCTION_RESULT_SIZE;
+                if (slot == PARAM_OTHER_RESULT_SLOT && rule->numWords > start) rule->paramOtherResults = 1;
+            }
+        }
+        table[tempRule->numParamValues].index = rule->numWords;
+        table[tempRule->numParamValues].mask = 0;
+    }
+    rule->resultStart = rule->numWords;
+    addRuleWords(rule, tempRule->result);
+}
+
+/**
+ * growRuleSet() - make room in the ruleset for one more rule
+ * 
+ * @ruleSet - the ruleset to grow
+ * @ruleSize - the size in bytes of the rule to add
+*/
+static void growRuleSet(RuleSet* ruleSet, long ruleSize)
+{
+    if (ruleSet->NUM_RULES == ruleSet->RULES_CAPACITY)
+    {
+        ruleSet->RULES_CAPACITY = ruleSet->RULES_CAPACITY == 0 ? 1024 : ruleSet->RULES_CAPACITY*2;
+        ruleSet->RULE_OFFSETS = (long*) realloc(ruleSet->RULE_OFFSETS, ruleSet->RULES_CAPACITY*sizeof(long));
+        ruleSet->RULE_ACTIVE = (int*) realloc(ruleSet->RULE_ACTIVE, ruleSet->RULES_CAPACITY*sizeof(int));
+        if (ruleSet->RULE_OFFSETS == NULL || ruleSet->RULE_ACTIVE == NULL)
+        {
+            printf("MALLOC FAILED!\n");
+            exit(1);
+        }
+    }
+    if (ruleSet->RULE_ARENA_SIZE + ruleSize > ruleSet->RULE_ARENA_CAPACITY)
+    {
+        long capacity = ruleSet->RULE_ARENA_CAPACITY == 0 ? (long) (1024*sizeof(Rule)) : ruleSet->RULE_ARENA_CAPACITY*2;
+        while (ruleSet->RULE_ARENA_SIZE + ruleSize > capacity) capacity *= 2;
+        ruleSet->RULE_ARENA = (char*) realloc(ruleSet->RULE_ARENA, capacity);
+        if (ruleSet->RULE_ARENA == NULL)
+        {
+            printf("MALLOC FAILED!\n");
+            exit(1);
+        }
+        ruleSet->RULE_ARENA_CAPACITY = capacity;
+    }
+}
+
 /**
  * pushTempRule() - tempRule is a working space to build rules quickly
  * temp rule is kindof similar toa  builder pattern
+ * the temp rule is compiled into a rule only storing its non-zero words
  * 
  * @ruleSet - the ruleset to put the temp rule
 */
@@ -138,6 +382,8 @@ void pushTempRule(RuleSet* ruleSet)
     {
         somethingInRuleExists |= ruleSet->temp_rule->result[i];
     }
+    somethingInRuleExists |= ruleSet->temp_rule->numCounted;
+    somethingInRuleExists |= ruleSet->temp_rule->numParamValues;
     if (somethingInRuleExists == 0)
     {
         printf("INVALID RULE MADE!\n");
@@ -146,8 +392,17 @@ void pushTempRule(RuleSet* ruleSet)
     //See if LHS is symmetric for an optimisation to checker
     ruleSet->temp_rule->LHSSymmetric = LHSSymmetric(ruleSet->temp_rule);
 
-    //Copy temp rule
-    memcpy(ruleSet->RULES[ruleSet->NUM_RULES], ruleSet->temp_rule, sizeof(Rule));
+    //Compile temp rule onto the end of the arena
+    long ruleSize = getCompiledRuleSize(ruleSet->temp_rule);
+    growRuleSet(ruleSet, ruleSize);
+    ruleSet->RULE_OFFSETS[ruleSet->NUM_RULES] = ruleSet->RULE_ARENA_SIZE;
+    ruleSet->RULE_ARENA_SIZE += ruleSize;
+    ruleSet->RULE_ACTIVE[ruleSet->NUM_RULES] = 1;
+    compileRule(ruleSet->temp_rule, getRule(ruleSet, ruleSet->NUM_RULES));
+
+    //Index the rule by the words it reads so the incremental inference can find it
+    addRuleWatchers(ruleSet, getRule(ruleSet, ruleSet->NUM_RULES), ruleSet->NUM_RULES);
+
     //added one more rule
     ruleSet->NUM_RULES++;
     //Reset temp rule
@@ -166,23 +421,219 @@ RuleSet* initRS()
     RuleSet* ruleSet = (RuleSet*) malloc(sizeof(RuleSet));
     printf("--Set num rules...\n");
     ruleSet->NUM_RULES = 0;
-    printf("--Reset rule...\n");
-    //Reset the rules by writing zeroes everywhere
-    for(int i = 0; i < MAX_NUM_RULES; i++)
+    printf("--Reset rule arena...\n");
+    //Rules are allocated as they are pushed
+    ruleSet->RULE_ARENA = NULL;
+    ruleSet->RULE_ARENA_SIZE = 0;
+    ruleSet->RULE_ARENA_CAPACITY = 0;
+    ruleSet->RULE_OFFSETS = NULL;
+    ruleSet->RULE_ACTIVE = NULL;
+    ruleSet->RULES_CAPACITY = 0;
+    printf("--Reset rule index...\n");
+    for (int set = 0; set < NUM_SETS; set++)
     {
-        ruleSet->RULES[i] = (Rule*) malloc(sizeof(Rule));
-        resetRule(ruleSet->RULES[i]);
-
-        ruleSet->RULE_ACTIVE[i] = 1;
+        for (int i = 0; i < FUNCTION_RESULT_SIZE; i++)
+        {
+            ruleSet->WATCHERS[set][i] = NULL;
+            ruleSet->WATCHER_VALUES[set][i] = NULL;
+            ruleSet->NUM_WATCHERS[set][i] = 0;
+            ruleSet->WATCHERS_CAPACITY[set][i] = 0;
+        }
     }
     printf("--Reset builder rule...\n");
-    ruleSet->temp_rule = (Rule*) malloc(sizeof(Rule));
+    ruleSet->temp_rule = (TempRule*) calloc(1, sizeof(TempRule));
+    if (ruleSet->temp_rule == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
     resetRule(ruleSet->temp_rule);
     printf("--Done!\n");
 
     return ruleSet;
 }
 
+/**
+ * copyArray() - copy an array into a new allocation of exactly its size
+ * 
+ * @src - the array to copy
+ * @size - size of the array in bytes
+ * 
+ * @return the copy (NULL if size is 0)
+*/
+static void* copyArray(void* src, long size)
+{
+    if (size == 0) return NULL;
+    void* copy = malloc(size);
+    if (copy == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    memcpy(copy, src, size);
+    return copy;
+}
+
+/**
+ * copyRuleSet() - make a read only copy of a ruleset, the copy has no temp rule so rules can't be pushed to it
+ * 
+ * @ruleSet - the ruleset to copy
+ * 
+ * @return the copy
+*/
+RuleSet* copyRuleSet(RuleSet* ruleSet)
+{
+    RuleSet* copy = (RuleSet*) malloc(sizeof(RuleSet));
+    if (copy == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    copy->NUM_RULES = ruleSet->NUM_RULES;
+    copy->RULES_CAPACITY = ruleSet->NUM_RULES;
+    copy->RULE_ARENA = (char*) copyArray(ruleSet->RULE_ARENA, ruleSet->RULE_ARENA_SIZE);
+    copy->RULE_ARENA_SIZE = ruleSet->RULE_ARENA_SIZE;
+    copy->RULE_ARENA_CAPACITY = ruleSet->RULE_ARENA_SIZE;
+    copy->RULE_OFFSETS = (long*) copyArray(ruleSet->RULE_OFFSETS, ruleSet->NUM_RULES*sizeof(long));
+    copy->RULE_ACTIVE = (int*) copyArray(ruleSet->RULE_ACTIVE, ruleSet->NUM_RULES*sizeof(int));
+    for (int set = 0; set < NUM_SETS; set++)
+    {
+        for (int i = 0; i < FUNCTION_RESULT_SIZE; i++)
+        {
+            copy->WATCHERS[set][i] = (int*) copyArray(ruleSet->WATCHERS[set][i], ruleSet->NUM_WATCHERS[set][i]*sizeof(int));
+            copy->WATCHER_VALUES[set][i] = (unsigned int*) copyArray(ruleSet->WATCHER_VALUES[set][i], ruleSet->NUM_WATCHERS[set][i]*sizeof(unsigned int));
+            copy->NUM_WATCHERS[set][i] = ruleSet->NUM_WATCHERS[set][i];
+            copy->WATCHERS_CAPACITY[set][i] = ruleSet->NUM_WATCHERS[set][i];
+        }
+    }
+    copy->temp_rule = NULL;
+    return copy;
+}
+
+/**
+ * freeRuleSet() - free a ruleset and all its rules
+ * 
+ * @ruleSet - the ruleset to free
+*/
+void freeRuleSet(RuleSet* ruleSet)
+{
+    free(ruleSet->RULE_ARENA);
+    free(ruleSet->RULE_OFFSETS);
+    free(ruleSet->RULE_ACTIVE);
+    for (int set = 0; set < NUM_SETS; set++)
+    {
+        for (int i = 0; i < FUNCTION_RESULT_SIZE; i++)
+        {
+            free(ruleSet->WATCHERS[set][i]);
+            free(ruleSet->WATCHER_VALUES[set][i]);
+        }
+    }
+    free(ruleSet->temp_rule);
+    free(ruleSet);
+}
+
+/**
+ * initVersionedRuleSet() - create versioned snapshots of a ruleset, publishing its current rules
+ * 
+ * @ruleSet - the ruleset to snapshot (keeps being owned and edited by the caller)
+ * @numReaders - the number of threads that will pin snapshots
+ * 
+ * @return the versioned ruleset
+*/
+VersionedRuleSet* initVersionedRuleSet(RuleSet* ruleSet, int numReaders)
+{
+    VersionedRuleSet* versions = (VersionedRuleSet*) malloc(sizeof(VersionedRuleSet));
+    if (versions == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    versions->NUM_READERS = numReaders;
+    versions->PINNED = (_Atomic(RuleSet*)*) malloc(numReaders*sizeof(_Atomic(RuleSet*)));
+    if (versions->PINNED == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    for (int reader = 0; reader < numReaders; reader++) atomic_init(&versions->PINNED[reader], NULL);
+    versions->RETIRED = NULL;
+    versions->NUM_RETIRED = 0;
+    versions->RETIRED_CAPACITY = 0;
+    versions->VERSION = 1;
+    atomic_init(&versions->CURRENT, copyRuleSet(ruleSet));
+    return versions;
+}
+
+/**
+ * isRuleSetPinned() - check if any reader has a snapshot pinned
+ * 
+ * @versions - the versioned ruleset
+ * @snapshot - the snapshot
+ * 
+ * @return 1 if pinned 0 otherwise
+*/
+static int isRuleSetPinned(VersionedRuleSet* versions, RuleSet* snapshot)
+{
+    for (int reader = 0; reader < versions->NUM_READERS; reader++)
+    {
+        if (atomic_load(&versions->PINNED[reader]) == snapshot) return 1;
+    }
+    return 0;
+}
+
+/**
+ * publishRuleSet() - publish a new snapshot of a ruleset, freeing old snapshots no reader has pinned
+ * 
+ * @versions - the versioned ruleset
+ * @ruleSet - the edited ruleset to snapshot
+*/
+void publishRuleSet(VersionedRuleSet* versions, RuleSet* ruleSet)
+{
+    RuleSet* old = atomic_exchange(&versions->CURRENT, copyRuleSet(ruleSet));
+    versions->VERSION++;
+
+    if (versions->NUM_RETIRED == versions->RETIRED_CAPACITY)
+    {
+        versions->RETIRED_CAPACITY = versions->RETIRED_CAPACITY == 0 ? 16 : versions->RETIRED_CAPACITY*2;
+        versions->RETIRED = (RuleSet**) realloc(versions->RETIRED, versions->RETIRED_CAPACITY*sizeof(RuleSet*));
+        if (versions->RETIRED == NULL)
+        {
+            printf("MALLOC FAILED!\n");
+            exit(1);
+        }
+    }
+    versions->RETIRED[versions->NUM_RETIRED] = old;
+    versions->NUM_RETIRED++;
+
+    //Readers check CURRENT again after pinning, so one that missed the new snapshot shows up here
+    int kept = 0;
+    for (int i = 0; i < versions->NUM_RETIRED; i++)
+    {
+        if (isRuleSetPinned(versions, versions->RETIRED[i])) versions->RETIRED[kept++] = versions->RETIRED[i];
+        else freeRuleSet(versions->RETIRED[i]);
+    }
+    versions->NUM_RETIRED = kept;
+}
+
+/**
+ * pinRuleSet() - pin the latest snapshot, it won't be freed until the reader pins another
+ * 
+ * @versions - the versioned ruleset
+ * @reader - the index of the reading thread
+ * 
+ * @return the snapshot (read only)
+*/
+RuleSet* pinRuleSet(VersionedRuleSet* versions, int reader)
+{
+    while (1)
+    {
+        RuleSet* snapshot = atomic_load(&versions->CURRENT);
+        atomic_store(&versions->PINNED[reader], snapshot);
+        //If a new snapshot was published meanwhile the publisher may not have seen the pin
+        if (atomic_load(&versions->CURRENT) == snapshot) return snapshot;
+    }
+}
+
 /**
  * resetTempRule() - reset the temp rule
  * 
@@ -214,7 +665,7 @@ void setTempRuleParams(RuleSet* rs, int varCount, int varsMutuallyExclusive)
  * @set the set of the element of the var
  * @function the function on the RHS
 */
-static void setRuleResult(Rule* rule, int resultVarName, int set, int function)
+static void setRuleResult(TempRule* rule, int resultVarName, int set, int function)
 {
     rule->resultVarName = resultVarName;
     rule->resultFromSet = set;
@@ -249,7 +700,7 @@ void setTempRuleResult(RuleSet* rs, int resultVarName, int set, int function)
  * @set the NAME of the set of the element of the var
  * @function the NAME of the function on the RHS
 */
-static void setRuleResultName(Rule* rule, KnowledgeBase* kb, int resultVarName, char* set, char* function)
+static void setRuleResultName(TempRule* rule, KnowledgeBase* kb, int resultVarName, char* set, char* function)
 {
     int setID = getSetIDWithName(kb, set, 1);
     int functionID = getSetFunctionIDWithName(kb, setID, function, 1);
@@ -280,7 +731,7 @@ void setTempRuleResultName(RuleSet* rs, KnowledgeBase* kb, int resultVarName, ch
  * @function the function on the RHS
  * @forcedSubstitution if the subsitution is forced to a specific element in the knowledge base
 */
-static void addConditionToRule(Rule* rule, int varName, int set, int function, int forcedSubstitution)
+static void addConditionToRule(TempRule* rule, int varName, int set, int function, int forcedSubstitution)
 {
     int index, bit;
     getIndexAndBit(&index, &bit, function);
@@ -315,7 +766,7 @@ void addConditionToTempRule(RuleSet* rs, int varName, int set, int function, int
  * @set the NAME of the set of the element of the var
  * @function the NAME of the function on the RHS
 */
-static void addConditionToRuleName(Rule* rule, KnowledgeBase* kb, int varName, char* set, char* function)
+static void addConditionToRuleName(TempRule* rule, KnowledgeBase* kb, int varName, char* set, char* function)
 {
     int setID = getSetIDWithName(kb, set, 1);
     int functionID = getSetFunctionIDWithName(kb, setID, function, 1);
@@ -347,7 +798,7 @@ void addConditionToTempRuleName(RuleSet* rs, KnowledgeBase* kb, int varName, cha
  * @function the NAME of the function on the RHS
  * @forcedSubstitution if the subsitution is forced to a specific element in the knowledge base
 */
-static void addFixedConditionToRuleName(Rule* rule, KnowledgeBase* kb, int varName, char* set, char* function, int forcedSubstitution)
+static void addFixedConditionToRuleName(TempRule* rule, KnowledgeBase* kb, int varName, char* set, char* function, int forcedSubstitution)
 {
     int setID = getSetIDWithName(kb, set, 1);
     int functionID = getSetFunctionIDWithName(kb, setID, function, 1);
@@ -371,88 +822,387 @@ void addFixedConditionToTempRuleName(RuleSet* rs, KnowledgeBase* kb, int varName
 }
 
 /**
- * canRuleProvideNovelInformation() - 
+ * setTempRuleCount() - make the temp rule a counting rule
+ * between minCount and maxCount of its counted functions are true (given its conditions are)
  * 
- * @rule
- * @kb the knowledge base the rule is for
+ * once maxCount are known true the rest are false, once only minCount can be true they all are
+ * this is checked with two counters rather than trying every assignment of variables
  * 
- * @return 1 if this rule can find novel information 0 if otherwise
+ * @rs the ruleset with the temp rule to set
+ * @minCount the fewest counted functions that can be true
+ * @maxCount the most counted functions that can be true
 */
-inline static int canRuleProvideNovelInformation(Rule* rule, KnowledgeBase* kb)
+void setTempRuleCount(RuleSet* rs, int minCount, int maxCount)
 {
-    for (int element = 0; element < kb->SET_SIZES[rule->resultFromSet]; element++)
+    rs->temp_rule->minCount = minCount;
+    rs->temp_rule->maxCount = maxCount;
+}
+
+/**
+ * addCountedToTempRule() - add a function to count to a counting temp rule
+ * 
+ * @rs the ruleset with the temp rule to add to
+ * @set the set of the element (the same for every counted function)
+ * @element the element the function is of
+ * @function the function to count
+ * @notFunction the function known when the counted function is false
+*/
+void addCountedToTempRule(RuleSet* rs, int set, int element, int function, int notFunction)
+{
+    TempRule* rule = rs->temp_rule;
+    if (rule->numCounted == MAX_COUNTED_IN_RULE)
     {
-        for (int i = 0; i < FUNCTION_RESULT_SIZE; i++)
-        {
-            if ((kb->KNOWLEDGE_BASE[rule->resultFromSet][element][i] & rule->result[i]) != rule->result[i]) return 1;
-        }
+        printf("TOO MANY COUNTED FUNCTIONS IN RULE!\n");
+        exit(1);
     }
-    return 0;
+    rule->countedFromSet = set;
+    rule->countedElements[rule->numCounted] = element;
+    rule->countedFunctions[rule->numCounted] = function;
+    rule->countedNotFunctions[rule->numCounted] = notFunction;
+    rule->numCounted++;
 }
 
 /**
- * optimiseRuleset() - optimise the ruleset by seeing how many rules can be disabled
- * due to lack of novel information they will provide
+ * addCountedToTempRuleName() - 
  * 
- * @rs the ruleset to optimise
+ * @rs the ruleset with the temp rule to add to
  * @kb the knowledge base the rule is for
+ * @set the NAME of the set of the element
+ * @element the element the function is of
+ * @function the NAME of the function to count
+ * @notFunction the NAME of the function known when the counted function is false
+*/
+void addCountedToTempRuleName(RuleSet* rs, KnowledgeBase* kb, char* set, int element, char* function, char* notFunction)
+{
+    int setID = getSetIDWithName(kb, set, 1);
+    int functionID = getSetFunctionIDWithName(kb, setID, function, 1);
+    int notFunctionID = getSetFunctionIDWithName(kb, setID, notFunction, 1);
+
+    addCountedToTempRule(rs, setID, element, functionID, notFunctionID);
+}
+
+/**
+ * setTempRuleTemplate() - make the temp rule a template standing for one rule per value of a parameter
+ * so per night or per player families are stored (and checked) as a single rule
  * 
- * @return 1 if this rule can find novel information 0 if otherwise
+ * @rs the ruleset with the temp rule to set
+ * @numParamValues the number of values of the parameter (at most MAX_SET_ELEMENTS)
+ * @paramVar the variable whose element is the parameter value (-1 if none)
 */
-void optimiseRuleset(RuleSet* rs, KnowledgeBase* kb)
+void setTempRuleTemplate(RuleSet* rs, int numParamValues, int paramVar)
 {
-    int count = 0;
-    for (int rule = 0; rule < rs->NUM_RULES; rule++)
+    if (numParamValues <= 0 || numParamValues > MAX_SET_ELEMENTS)
     {
-       rs->RULE_ACTIVE[rule] = canRuleProvideNovelInformation(rs->RULES[rule], kb);
-       if (rs->RULE_ACTIVE[rule] == 0) count++;
+        printf("INVALID RULE MADE!\n");
+        exit(1);
     }
-    //printf("%d / %d rules disabled\n", count, rs->NUM_RULES);
+    rs->temp_rule->numParamValues = numParamValues;
+    rs->temp_rule->paramVar = paramVar;
 }
 
 /**
- * printRule() - 
+ * addParamFunctionToRule() - add a function depending on the parameter value to one slot of every value of a template
  * 
- * @rule the rule to print
+ * @rule the template rule
  * @kb the knowledge base the rule is for
+ * @slot the slot of the parametric words to add to
+ * @set the setID of the function
+ * @functionFormat the NAME of the function with a %d for the parameter value
+ * @offset added to the parameter value when writing the name
 */
-void printRule(Rule* rule, KnowledgeBase* kb)
+static void addParamFunctionToRule(TempRule* rule, KnowledgeBase* kb, int slot, int set, char* functionFormat, int offset)
 {
-    //printf("PR-0\n"); //Remove
-    int finalCount = 0;
-    int count = 0;
-    //Print conditions
-    for (int var = 0; var < rule->varCount; var++)
+    char buff[STRING_BUFF_SIZE];
+    for (int value = 0; value < rule->numParamValues; value++)
     {
-        //printf("PR-1\n"); //Remove
-        finalCount = 0;
-        for(int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
-        {
-            int index, bit;
-            getIndexAndBit(&index, &bit, function);
-            
-            if (rule->varConditions[var][index] & (1L << bit))
-            {
-                finalCount++;
-            }
+        if (value + offset < 0 || value + offset >= rule->numParamValues)
+        { //No function for this value so no instance of the rule either
+            rule->paramMissing[value] = 1;
+            continue;
         }
-        count = 0;
-        //printf("PR-2\n"); //Remove
-        for(int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
-        {
-            //printf("PR-2A\n"); //Remove
-            int index, bit;
-            getIndexAndBit(&index, &bit, function);
-            //printf("PR-2B\n"); //Remove
-            if (rule->varConditions[var][index] & (1L << bit))
-            {
-                //printf("PR-2C\n"); //Remove
-                //printf("PR-2CA %d\n", dgufgd); //Remove
-                printf("%s(%d:%s)", kb->FUNCTION_NAME[rule->varConditionFromSet[var]][function], var, kb->SET_NAMES[rule->varConditionFromSet[var]]);
-                count++;
-                //printf("PR-2D\n"); //Remove
-                if (count < finalCount)
-                {
+        snprintf(buff, STRING_BUFF_SIZE, functionFormat, value + offset);
+
+        int index, bit;
+        getIndexAndBit(&index, &bit, getSetFunctionIDWithName(kb, set, buff, 1));
+        rule->paramWords[value][slot][index] |= 1L << bit;
+    }
+}
+
+/**
+ * addParamConditionToTempRuleName() - add a condition whose function depends on the parameter value
+ * a value whose function would be out of range has no instance of the rule
+ * 
+ * @rs the ruleset with the temp rule to add the condition to
+ * @kb the knowledge base the rule is for
+ * @varName the var name on the LHS
+ * @set the NAME of the set of the element of the var
+ * @functionFormat the NAME of the function with a %d for the parameter value
+ * @offset added to the parameter value when writing the name (e.g. 1 for the next night)
+*/
+void addParamConditionToTempRuleName(RuleSet* rs, KnowledgeBase* kb, int varName, char* set, char* functionFormat, int offset)
+{
+    int setID = getSetIDWithName(kb, set, 1);
+
+    addParamFunctionToRule(rs->temp_rule, kb, varName, setID, functionFormat, offset);
+    rs->temp_rule->varConditionFromSet[varName] = setID;
+    rs->temp_rule->varsForcedSubstitutions[varName] = -1;
+}
+
+/**
+ * setParamTempRuleResultName() - add a result whose function depends on the parameter value
+ * 
+ * @rs the ruleset with the temp rule to set the result of
+ * @kb the knowledge base the rule is for
+ * @resultVarName the var name on the RHS
+ * @set the NAME of the set of the element of the var
+ * @functionFormat the NAME of the function with a %d for the parameter value
+ * @offset added to the parameter value when writing the name
+*/
+void setParamTempRuleResultName(RuleSet* rs, KnowledgeBase* kb, int resultVarName, char* set, char* functionFormat, int offset)
+{
+    int setID = getSetIDWithName(kb, set, 1);
+
+    addParamFunctionToRule(rs->temp_rule, kb, PARAM_RESULT_SLOT, setID, functionFormat, offset);
+    rs->temp_rule->resultVarName = resultVarName;
+    rs->temp_rule->resultFromSet = setID;
+}
+
+/**
+ * setOtherParamTempRuleResultName() - add a result of the function for every parameter value except the rules own
+ * e.g. killing player X means not killing any other player
+ * 
+ * @rs the ruleset with the temp rule to set the result of
+ * @kb the knowledge base the rule is for
+ * @resultVarName the var name on the RHS
+ * @set the NAME of the set of the element of the var
+ * @functionFormat the NAME of the function with a %d for the parameter value
+*/
+void setOtherParamTempRuleResultName(RuleSet* rs, KnowledgeBase* kb, int resultVarName, char* set, char* functionFormat)
+{
+    int setID = getSetIDWithName(kb, set, 1);
+
+    addParamFunctionToRule(rs->temp_rule, kb, PARAM_OTHER_RESULT_SLOT, setID, functionFormat, 0);
+    rs->temp_rule->resultVarName = resultVarName;
+    rs->temp_rule->resultFromSet = setID;
+}
+
+/**
+ * getParamStart() - get where the parametric words of a value of a template start
+ * 
+ * @rule the template rule
+ * @value the parameter value
+ * 
+ * @return the index of the first word of the value
+*/
+static inline int getParamStart(Rule* rule, int value)
+{
+    return rule->words[rule->paramStart + value].index;
+}
+
+/**
+ * getParamEnd() - get where the parametric words of a value of a template end
+ * 
+ * @rule the template rule
+ * @value the parameter value
+ * 
+ * @return the index after the last word of the value
+*/
+static inline int getParamEnd(Rule* rule, int value)
+{
+    return rule->words[rule->paramStart + value + 1].index;
+}
+
+/**
+ * canRuleProvideNovelInformation() - 
+ * 
+ * @rule
+ * @kb the knowledge base the rule is for
+ * 
+ * @return 1 if this rule can find novel information 0 if otherwise
+*/
+inline static int canRuleProvideNovelInformation(Rule* rule, KnowledgeBase* kb)
+{
+    if (rule->numCounted > 0)
+    { //Only counted functions that are still unknown can be found
+        long* knowledge = &kb->KNOWLEDGE_BASE[rule->countedFromSet][0][0];
+        for (int i = rule->countedStart; i < rule->resultStart; i += 2)
+        {
+            if ((knowledge[rule->words[i].index] & rule->words[i].mask) == 0 && 
+                (knowledge[rule->words[i+1].index] & rule->words[i+1].mask) == 0) return 1;
+        }
+        return 0;
+    }
+    for (int element = 0; element < kb->SET_SIZES[rule->resultFromSet]; element++)
+    {
+        for (int i = rule->resultStart; i < rule->numWords; i++)
+        {
+            if ((kb->KNOWLEDGE_BASE[rule->resultFromSet][element][rule->words[i].index] & rule->words[i].mask) != rule->words[i].mask) return 1;
+        }
+        if (rule->numParamValues == 0) continue;
+        //The result of every value of a template
+        for (int i = getParamStart(rule, 0); i < getParamEnd(rule, rule->numParamValues-1); i++)
+        {
+            if (rule->words[i].index / FUNCTION_RESULT_SIZE < PARAM_RESULT_SLOT) continue;
+            int index = rule->words[i].index % FUNCTION_RESULT_SIZE;
+            if ((kb->KNOWLEDGE_BASE[rule->resultFromSet][element][index] & rule->words[i].mask) != rule->words[i].mask) return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * optimiseRuleset() - optimise the ruleset by seeing how many rules can be disabled
+ * due to lack of novel information they will provide
+ * 
+ * @rs the ruleset to optimise
+ * @kb the knowledge base the rule is for
+ * 
+ * @return 1 if this rule can find novel information 0 if otherwise
+*/
+void optimiseRuleset(RuleSet* rs, KnowledgeBase* kb)
+{
+    int count = 0;
+    for (int rule = 0; rule < rs->NUM_RULES; rule++)
+    {
+       rs->RULE_ACTIVE[rule] = canRuleProvideNovelInformation(getRule(rs, rule), kb);
+       if (rs->RULE_ACTIVE[rule] == 0) count++;
+    }
+    //printf("%d / %d rules disabled\n", count, rs->NUM_RULES);
+}
+
+/**
+ * getParamWord() - get a word of one slot of the parametric words of a template
+ * 
+ * @rule the template rule
+ * @value the parameter value
+ * @slot the slot of the word
+ * @index the word index
+ * 
+ * @return the functions in that word (0 if none)
+*/
+static long getParamWord(Rule* rule, int value, int slot, int index)
+{
+    for (int i = getParamStart(rule, value); i < getParamEnd(rule, value); i++)
+    {
+        if (rule->words[i].index == slot*FUNCTION_RESULT_SIZE + index) return rule->words[i].mask;
+    }
+    return 0;
+}
+
+/**
+ * getRuleConditionWord() - get a word of a variables conditions
+ * 
+ * @rule the rule
+ * @var the variable
+ * @index the word index
+ * @value the parameter value of a template (-1 if not a template)
+ * 
+ * @return the conditions in that word (0 if none)
+*/
+static long getRuleConditionWord(Rule* rule, int var, int index, int value)
+{
+    long word = value >= 0 ? getParamWord(rule, value, var, index) : 0;
+    for (int i = rule->varConditionStart[var]; i < rule->varConditionStart[var+1]; i++)
+    {
+        if (rule->words[i].index == index) return word | rule->words[i].mask;
+    }
+    return word;
+}
+
+/**
+ * getRuleResultWord() - get a word of a rules result
+ * 
+ * @rule the rule
+ * @index the word index
+ * @value the parameter value of a template (-1 if not a template)
+ * 
+ * @return the results in that word (0 if none)
+*/
+static long getRuleResultWord(Rule* rule, int index, int value)
+{
+    long word = 0;
+    if (value >= 0)
+    {
+        word |= getParamWord(rule, value, PARAM_RESULT_SLOT, index);
+        for (int other = 0; other < rule->numParamValues; other++)
+        {
+            if (other != value) word |= getParamWord(rule, other, PARAM_OTHER_RESULT_SLOT, index);
+        }
+    }
+    for (int i = rule->resultStart; i < rule->numWords; i++)
+    {
+        if (rule->words[i].index == index) return word | rule->words[i].mask;
+    }
+    return word;
+}
+
+/**
+ * printCountedFunctions() - print the counting side of a counting rule
+ * 
+ * @rule the counting rule
+ * @kb the knowledge base the rule is for
+*/
+static void printCountedFunctions(Rule* rule, KnowledgeBase* kb)
+{
+    printf("%d TO %d OF ", rule->minCount, rule->maxCount);
+    for (int i = 0; i < rule->numCounted; i++)
+    {
+        RuleWord* word = &rule->words[rule->countedStart + 2*i];
+        int element = word->index / FUNCTION_RESULT_SIZE;
+        int function = (word->index % FUNCTION_RESULT_SIZE)*INT_LENGTH + __builtin_ctzl(word->mask);
+        printf("%s(%d:%s)", kb->SCHEMA->FUNCTION_NAME[rule->countedFromSet][function], element, kb->SCHEMA->SET_NAMES[rule->countedFromSet]);
+        if (i+1 < rule->numCounted)
+        {
+            printf(", ");
+        }
+    }
+    printf("\n");
+}
+
+/**
+ * printRuleValue() - 
+ * 
+ * @rule the rule to print
+ * @kb the knowledge base the rule is for
+ * @value the parameter value of a template (-1 if not a template)
+*/
+static void printRuleValue(Rule* rule, KnowledgeBase* kb, int value)
+{
+    //printf("PR-0\n"); //Remove
+    int finalCount = 0;
+    int count = 0;
+    //Print conditions
+    for (int var = 0; var < rule->varCount; var++)
+    {
+        //printf("PR-1\n"); //Remove
+        finalCount = 0;
+        for(int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
+        {
+            int index, bit;
+            getIndexAndBit(&index, &bit, function);
+            
+            if (getRuleConditionWord(rule, var, index, value) & (1L << bit))
+            {
+                finalCount++;
+            }
+        }
+        count = 0;
+        //printf("PR-2\n"); //Remove
+        for(int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
+        {
+            //printf("PR-2A\n"); //Remove
+            int index, bit;
+            getIndexAndBit(&index, &bit, function);
+            //printf("PR-2B\n"); //Remove
+            if (getRuleConditionWord(rule, var, index, value) & (1L << bit))
+            {
+                //printf("PR-2C\n"); //Remove
+                //printf("PR-2CA %d\n", dgufgd); //Remove
+                printf("%s(%d:%s)", kb->SCHEMA->FUNCTION_NAME[rule->varConditionFromSet[var]][function], var, kb->SCHEMA->SET_NAMES[rule->varConditionFromSet[var]]);
+                count++;
+                //printf("PR-2D\n"); //Remove
+                if (count < finalCount)
+                {
                     printf(" ^ ");
                 }
             }
@@ -461,6 +1211,11 @@ void printRule(Rule* rule, KnowledgeBase* kb)
     }
     //printf("PR-3\n"); //Remove
     printf(" => ");
+    if (rule->numCounted > 0)
+    {
+        printCountedFunctions(rule, kb);
+        return;
+    }
     //Print result
     finalCount = 0;
     for(int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
@@ -468,7 +1223,7 @@ void printRule(Rule* rule, KnowledgeBase* kb)
         int index, bit;
         getIndexAndBit(&index, &bit, function);
         
-        if (rule->result[index] & (1L << bit))
+        if (getRuleResultWord(rule, index, value) & (1L << bit))
         {
             finalCount++;
         }
@@ -480,9 +1235,9 @@ void printRule(Rule* rule, KnowledgeBase* kb)
         int index, bit;
         getIndexAndBit(&index, &bit, function);
         
-        if (rule->result[index] & (1L << bit))
+        if (getRuleResultWord(rule, index, value) & (1L << bit))
         {
-            printf("%s(%d:%s)", kb->FUNCTION_NAME[rule->resultFromSet][function], rule->resultVarName, kb->SET_NAMES[rule->resultFromSet]);
+            printf("%s(%d:%s)", kb->SCHEMA->FUNCTION_NAME[rule->resultFromSet][function], rule->resultVarName, kb->SCHEMA->SET_NAMES[rule->resultFromSet]);
             count++;
             if (count < finalCount)
             {
@@ -494,14 +1249,37 @@ void printRule(Rule* rule, KnowledgeBase* kb)
 }
 
 /**
- * printRuleAssignment() - 
+ * printRule() - 
+ * 
+ * @rule the rule to print
+ * @kb the knowledge base the rule is for
+*/
+void printRule(Rule* rule, KnowledgeBase* kb)
+{
+    if (rule->numParamValues == 0)
+    {
+        printRuleValue(rule, kb, -1);
+        return;
+    }
+    //Print each rule the template stands for
+    for (int value = 0; value < rule->numParamValues; value++)
+    {
+        if (rule->words[rule->paramStart + value].mask == 0) continue;
+        printf("[%d] ", value);
+        printRuleValue(rule, kb, value);
+    }
+}
+
+/**
+ * printRuleAssignmentValue() - 
  * 
  * @rule the rule to print
  * @kb the knowledge base the rule is for
  * @assignement assignment for LHS
  * @resultAssignement assignment for RHS
+ * @value the parameter value of a template (-1 if not a template)
 */
-void printRuleAssignment(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS_IN_RULE], int resultAssignement)
+static void printRuleAssignmentValue(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS_IN_RULE], int resultAssignement, int value)
 {
     int finalCount = 0;
     int count = 0;
@@ -514,7 +1292,7 @@ void printRuleAssignment(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS
             int index, bit;
             getIndexAndBit(&index, &bit, function);
             
-            if (rule->varConditions[var][index] & (1L << bit))
+            if (getRuleConditionWord(rule, var, index, value) & (1L << bit))
             {
                 finalCount++;
             }
@@ -525,9 +1303,9 @@ void printRuleAssignment(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS
             int index, bit;
             getIndexAndBit(&index, &bit, function);
             
-            if (rule->varConditions[var][index] & (1L << bit))
+            if (getRuleConditionWord(rule, var, index, value) & (1L << bit))
             {
-                printf("%s(%d:%s)", kb->FUNCTION_NAME[rule->varConditionFromSet[var]][function], assignement[var], kb->SET_NAMES[rule->varConditionFromSet[var]]);
+                printf("%s(%d:%s)", kb->SCHEMA->FUNCTION_NAME[rule->varConditionFromSet[var]][function], assignement[var], kb->SCHEMA->SET_NAMES[rule->varConditionFromSet[var]]);
                 count++;
                 if (count < finalCount || var+1 < rule->varCount)
                 {
@@ -537,6 +1315,11 @@ void printRuleAssignment(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS
         }
     }
     printf(" => ");
+    if (rule->numCounted > 0)
+    {
+        printCountedFunctions(rule, kb);
+        return;
+    }
     //Print result
     finalCount = 0;
     for(int function = 0; function < FUNCTION_RESULT_SIZE*INT_LENGTH; function++)
@@ -544,7 +1327,7 @@ void printRuleAssignment(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS
         int index, bit;
         getIndexAndBit(&index, &bit, function);
         
-        if (rule->result[index] & (1L << bit))
+        if (getRuleResultWord(rule, index, value) & (1L << bit))
         {
             finalCount++;
         }
@@ -555,9 +1338,9 @@ void printRuleAssignment(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS
         int index, bit;
         getIndexAndBit(&index, &bit, function);
         
-        if (rule->result[index] & (1L << bit))
+        if (getRuleResultWord(rule, index, value) & (1L << bit))
         {
-            printf("%s(%d:%s)", kb->FUNCTION_NAME[rule->resultFromSet][function], resultAssignement, kb->SET_NAMES[rule->resultFromSet]);
+            printf("%s(%d:%s)", kb->SCHEMA->FUNCTION_NAME[rule->resultFromSet][function], resultAssignement, kb->SCHEMA->SET_NAMES[rule->resultFromSet]);
             count++;
             if (count < finalCount)
             {
@@ -568,18 +1351,31 @@ void printRuleAssignment(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS
     printf("\n");
 }
 
+/**
+ * printRuleAssignment() - 
+ * 
+ * @rule the rule to print
+ * @kb the knowledge base the rule is for
+ * @assignement assignment for LHS
+ * @resultAssignement assignment for RHS
+*/
+void printRuleAssignment(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS_IN_RULE], int resultAssignement)
+{
+    printRuleAssignmentValue(rule, kb, assignement, resultAssignement, -1);
+}
+
 /**
  * getAssignment() - recursivley assign variables by permuting the variables which are satisfied
  * 
  * @satisfied the variables elementIDs which satisfy condition [index]
  * @lengths the lengths
  * @assignment the output assignment array
- * @var the variable for the recursive nature
  * @count the seed which generates the permutation
+ * @varCount the number of variables in the rule (lengths past this are 0)
 */
-static inline void getAssignment(int satisfied[MAX_VARS_IN_RULE][MAX_SET_ELEMENTS], int lengths[MAX_VARS_IN_RULE], int assignment[MAX_VARS_IN_RULE], long count)
+static inline void getAssignment(int satisfied[MAX_VARS_IN_RULE][MAX_SET_ELEMENTS], int lengths[MAX_VARS_IN_RULE], int assignment[MAX_VARS_IN_RULE], long count, int varCount)
 {
-    for (int var = 0; var < MAX_VARS_IN_RULE; var++)
+    for (int var = 0; var < varCount; var++)
     {
         int nextCount = count / lengths[var];
         int takeFromList = count - (nextCount * lengths[var]);
@@ -591,22 +1387,81 @@ static inline void getAssignment(int satisfied[MAX_VARS_IN_RULE][MAX_SET_ELEMENT
 }
 
 /**
- * applyResult() - 
+ * applyResultWord() - set the bits of a mask in one word of an element
  * 
  * @kb
- * @result
  * @set
  * @element
+ * @i the word index
+ * @result the bits to set
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * @contradiction OUTPUTS set to TRUE if the word now has a function and its negation
+ * 
+ * @return TRUE if the word changed
+*/
+static inline int applyResultWord(KnowledgeBase* kb, int set, int element, int i, long result, long changedWords[NUM_SETS], int* contradiction)
+{
+    int novelWord = (kb->KNOWLEDGE_BASE[set][element][i] & result) != result;
+    if (novelWord && changedWords != NULL) changedWords[set] |= 1L << i;
+    if (novelWord) recordKnowledgeWord(kb, &kb->KNOWLEDGE_BASE[set][element][i]);
+    kb->KNOWLEDGE_BASE[set][element][i] |= result;
+    if (novelWord) *contradiction |= hasContradictionInWord(kb->KNOWLEDGE_BASE[set][element][i]);
+    return novelWord;
+}
+
+/**
+ * applyParamResult() - apply the parametric words in one result slot of a value of a template
+ * 
+ * @kb
+ * @rule the template rule
+ * @element
+ * @value the parameter value the words are for
+ * @slot PARAM_RESULT_SLOT or PARAM_OTHER_RESULT_SLOT
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * @contradiction OUTPUTS set to TRUE if a changed word now has a function and its negation
+ * 
+ * @return TRUE if a word changed
+*/
+static inline int applyParamResult(KnowledgeBase* kb, Rule* rule, int element, int value, int slot, long changedWords[NUM_SETS], int* contradiction)
+{
+    int novelInformation = 0;
+    //The result slots are the last in a value's words so walk back to them
+    for (int r = getParamEnd(rule, value) - 1; r >= getParamStart(rule, value) && rule->words[r].index / FUNCTION_RESULT_SIZE >= slot; r--)
+    {
+        if (rule->words[r].index / FUNCTION_RESULT_SIZE != slot) continue;
+        novelInformation |= applyResultWord(kb, rule->resultFromSet, element, rule->words[r].index % FUNCTION_RESULT_SIZE, rule->words[r].mask, changedWords, contradiction);
+    }
+    return novelInformation;
+}
+
+/**
+ * applyResult() - 
+ * only the words changed can become contradictions so they are checked as they are written
+ * 
+ * @kb
+ * @rule the rule whose result to apply
+ * @element
+ * @value the parameter value of a template (-1 if not a template)
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * @contradiction OUTPUTS set to TRUE if a changed word now has a function and its negation
  * 
  * @return
 */
-static inline int applyResult(KnowledgeBase* kb, long result[FUNCTION_RESULT_SIZE], int set, int element)
+static inline int applyResult(KnowledgeBase* kb, Rule* rule, int element, int value, long changedWords[NUM_SETS], int* contradiction)
 {
+    int set = rule->resultFromSet;
     int novelInformation = 0;
-    for (int i = 0; i < FUNCTION_RESULT_SIZE; i++)
+    for (int r = rule->resultStart; r < rule->numWords; r++)
     {
-        novelInformation |= (kb->KNOWLEDGE_BASE[set][element][i] & result[i]) != result[i];
-        kb->KNOWLEDGE_BASE[set][element][i] |= result[i];
+        novelInformation |= applyResultWord(kb, set, element, rule->words[r].index, rule->words[r].mask, changedWords, contradiction);
+    }
+    if (value >= 0)
+    {
+        novelInformation |= applyParamResult(kb, rule, element, value, PARAM_RESULT_SLOT, changedWords, contradiction);
+        for (int other = 0; rule->paramOtherResults && other < rule->numParamValues; other++)
+        { //Most templates have no other results so skip the walk over every value
+            if (other != value) novelInformation |= applyParamResult(kb, rule, element, other, PARAM_OTHER_RESULT_SLOT, changedWords, contradiction);
+        }
     }
     return novelInformation;
 }
@@ -617,19 +1472,22 @@ static inline int applyResult(KnowledgeBase* kb, long result[FUNCTION_RESULT_SIZ
  * @rule
  * @kb
  * @assignment
+ * @value the parameter value of a template (-1 if not a template)
  * @verbose
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * @contradiction OUTPUTS set to TRUE if a contradiction was added
  * 
  * @return
 */
-static int applyRule(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS_IN_RULE], int verbose)
+static int applyRule(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS_IN_RULE], int value, int verbose, long changedWords[NUM_SETS], int* contradiction)
 {
     int foundNovelInformation = 0;
     if (rule->resultVarName >= 0)
     { //Result found in condition
-        if (applyResult(kb, rule->result, rule->resultFromSet, assignement[rule->resultVarName]))
+        if (applyResult(kb, rule, assignement[rule->resultVarName], value, changedWords, contradiction))
         {
             foundNovelInformation = 1;
-            if (verbose) printRuleAssignment(rule, kb, assignement, assignement[rule->resultVarName]);
+            if (verbose) printRuleAssignmentValue(rule, kb, assignement, assignement[rule->resultVarName], value);
         }
         
     }
@@ -646,10 +1504,10 @@ static int applyRule(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS_IN_
                     break;
                 }
             }
-            if (inAssignment == 0 && applyResult(kb, rule->result, rule->resultFromSet, setElement))
+            if (inAssignment == 0 && applyResult(kb, rule, setElement, value, changedWords, contradiction))
             {
                 foundNovelInformation = 1;
-                if (verbose) printRuleAssignment(rule, kb, assignement, setElement);
+                if (verbose) printRuleAssignmentValue(rule, kb, assignement, setElement, value);
             }
         }
         
@@ -661,10 +1519,10 @@ static int applyRule(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS_IN_
     { //Result can be ONLY -1XXX where XXX is the element ID
         int varToSub = (-rule->resultVarName)-1000;
 
-        if (applyResult(kb, rule->result, rule->resultFromSet, varToSub))
+        if (applyResult(kb, rule, varToSub, value, changedWords, contradiction))
         {
             foundNovelInformation = 1;
-            if (verbose) printRuleAssignment(rule, kb, assignement, varToSub);
+            if (verbose) printRuleAssignmentValue(rule, kb, assignement, varToSub, value);
         }
     }
     return foundNovelInformation;
@@ -678,12 +1536,19 @@ static int applyRule(Rule* rule, KnowledgeBase* kb, int assignement[MAX_VARS_IN_
  * @set 
  * @element
  * @var
+ * @paramFrom the first parametric word of var for the template value being checked
+ * @paramTo the word after the last parametric word of var (equal to paramFrom if there are none)
 */
-static inline int elementSatisfiesVarConditions(Rule* rule, KnowledgeBase* kb, int set, int element, int var)
+static inline int elementSatisfiesVarConditions(Rule* rule, KnowledgeBase* kb, int set, int element, int var, int paramFrom, int paramTo)
 {
-    for(int i = 0; i < FUNCTION_RESULT_SIZE; i++)
+    long* knowledge = kb->KNOWLEDGE_BASE[set][element];
+    for (int i = paramFrom; i < paramTo; i++)
+    {
+        if ((knowledge[rule->words[i].index % FUNCTION_RESULT_SIZE] & rule->words[i].mask) != rule->words[i].mask) return 0;
+    }
+    for(int i = rule->varConditionStart[var]; i < rule->varConditionStart[var+1]; i++)
     {
-        if ((kb->KNOWLEDGE_BASE[set][element][i] & rule->varConditions[var][i]) != rule->varConditions[var][i]) return 0;
+        if ((knowledge[rule->words[i].index] & rule->words[i].mask) != rule->words[i].mask) return 0;
     }
     return 1;
 }
@@ -698,22 +1563,31 @@ static inline int elementSatisfiesVarConditions(Rule* rule, KnowledgeBase* kb, i
  * @kb the knowledge base
  * @satisfied writing what variables satisfy the result
  * @lengths how many variables satisfy the result
+ * @value the parameter value of a template (-1 if not a template)
  * 
  * @return returns 0 if the valid substitutions trivially won't work (lengths[x] == 0 for some x), 1 otherwise
 */
-static inline int findPossibleSubstitutions(Rule* rule, KnowledgeBase* kb, int satisfied[MAX_VARS_IN_RULE][MAX_SET_ELEMENTS], int lengths[MAX_VARS_IN_RULE])
+static inline int findPossibleSubstitutions(Rule* rule, KnowledgeBase* kb, int satisfied[MAX_VARS_IN_RULE][MAX_SET_ELEMENTS], int lengths[MAX_VARS_IN_RULE], int value)
 {
+    //The words of a value are in slot order so each var's are a contiguous run
+    int paramFrom = 0, paramTo = 0;
+    int paramEnd = (value >= 0) ? getParamEnd(rule, value) : 0;
+    if (value >= 0) paramTo = getParamStart(rule, value);
+
     //Loop through vars in rules
     for (int var = 0; var<rule->varCount; var++)
     {
         lengths[var] = 0;
 
+        paramFrom = paramTo;
+        while (paramTo < paramEnd && rule->words[paramTo].index / FUNCTION_RESULT_SIZE == var) paramTo++;
+
         int set = rule->varConditionFromSet[var];
-        int forcedSub = rule->varsForcedSubstitutions[var];
+        int forcedSub = (value >= 0 && var == rule->paramVar) ? value : rule->varsForcedSubstitutions[var];
         if (forcedSub != -1)
         {  //Look for forced substitutions
             //Check if the variable that has the forced substitution satisfies condition
-            if (elementSatisfiesVarConditions(rule, kb, set, forcedSub, var))
+            if (elementSatisfiesVarConditions(rule, kb, set, forcedSub, var, paramFrom, paramTo))
             {
                 satisfied[var][lengths[var]] = forcedSub;
                 lengths[var]++;
@@ -723,9 +1597,9 @@ static inline int findPossibleSubstitutions(Rule* rule, KnowledgeBase* kb, int s
         else
         { //If not forced sub check all elements
             //Loop through elements of sets
-            for(int element = 0; element<MAX_SET_ELEMENTS; element++)
+            for(int element = 0; element<kb->SET_SIZES[set]; element++)
             {
-                if (elementSatisfiesVarConditions(rule, kb, set, element, var))
+                if (elementSatisfiesVarConditions(rule, kb, set, element, var, paramFrom, paramTo))
                 { //in "set": fact num "element" would satisfy var number "var"
                     satisfied[var][lengths[var]] = element;
                     lengths[var]++;
@@ -753,109 +1627,746 @@ static inline int isRepeatVar(int assignement[MAX_VARS_IN_RULE], int varCount)
 }
 
 /**
- * satisfiesRule() - check if a knowledge base satisfies a rules LHS in a novel way
- * if it is add novel information to the KB
- * 
- * A novel solution is descibed as
- * 
- * X AND Y AND Z AND ... => A
- * 
- * WHERE KB already knows X,Y,Z,... but does NOT know A (so it's novel)
- * 
- * NOTE: this is used for optimisations with how many implication rounds to run when infering facts
+ * applyAllAssignments() - apply a rule for every assignment of its possible substitutions
  * 
- * @rule the rule to check if the LHS is satsified
+ * @rule the rule to apply
  * @kb the knowledge base
+ * @satisfied the elements that satisfy the conditions of each var
+ * @lengths how many elements satisfy the conditions of each var
+ * @value the parameter value of a template (-1 if not a template)
  * @verbose print out information
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * @contradiction OUTPUTS set to TRUE if a contradiction was added
  * 
  * @return TRUE if a novel solution is found
 */
-int satisfiesRule(Rule* rule, KnowledgeBase* kb, int verbose)
+static int applyAllAssignments(Rule* rule, KnowledgeBase* kb, int satisfied[MAX_VARS_IN_RULE][MAX_SET_ELEMENTS], int lengths[MAX_VARS_IN_RULE], int value, int verbose, long changedWords[NUM_SETS], int* contradiction)
+{
+    int assignement[MAX_VARS_IN_RULE];
+    int foundNovelSolution = 0;
+
+    //Figure out how many combinations we have
+    long numCombinations = 1;
+    for (int var = 0; var < rule->varCount; var++) numCombinations *= lengths[var];
+
+    for(long count = 0; count < numCombinations; count++)
+    {
+        //Generate Assignement
+        getAssignment(satisfied, lengths, assignement, count, rule->varCount);
+
+        if (!rule->varsMutuallyExclusive || !isRepeatVar(assignement, rule->varCount))
+        { //If the assignement is valid
+            //Update Knowledge Base
+            foundNovelSolution |= applyRule(rule, kb, assignement, value, verbose, changedWords, contradiction); //If some novel information was added
+        }
+    }
+    return foundNovelSolution;
+}
+
+/**
+ * applySymmetricAssignments() - apply a rule whose LHS is symmetric without permuting its vars
+ * as every var has the same substitutions only one ordering of them needs to be applied
+ * 
+ * @rule the rule to apply
+ * @kb the knowledge base
+ * @satisfied the elements that satisfy the conditions of each var
+ * @lengths how many elements satisfy the conditions of each var
+ * @value the parameter value of a template (-1 if not a template)
+ * @verbose print out information
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * @contradiction OUTPUTS set to TRUE if a contradiction was added
+ * 
+ * @return TRUE if a novel solution is found
+*/
+static int applySymmetricAssignments(Rule* rule, KnowledgeBase* kb, int satisfied[MAX_VARS_IN_RULE][MAX_SET_ELEMENTS], int lengths[MAX_VARS_IN_RULE], int value, int verbose, long changedWords[NUM_SETS], int* contradiction)
+{
+    int assignement[MAX_VARS_IN_RULE];
+    int foundNovelSolution = 0;
+
+    //Test If Assignement is valid
+    if (rule->varsMutuallyExclusive)
+    {
+        if (lengths[0] < rule->varCount) //Only check first variable lengths[0] as symmetric so lengths[0]==lengths[i] for all i
+        { //Lengths < rule->varCount   ---> no valid substitutions
+        }
+        else if (lengths[0] == rule->varCount)
+        { //Lengths == rule->varCount   ---> One valid substitution
+            for (int var = 0; var < rule->varCount; var++)
+            {
+                assignement[var] = satisfied[var][var];
+            }
+            //If the assignement is valid
+            //Update Knowledge Base
+            foundNovelSolution |= applyRule(rule, kb, assignement, value, verbose, changedWords, contradiction); //If some novel information was added
+        }
+        else
+        { //Lengths > rule->varCount   ---> Multiple valid substitutions
+            for (int potentialSub = 0; potentialSub < lengths[0]; potentialSub++)
+            { //Use potential sub as the variable to ignore
+                int count = 0;
+                for (int var = 0; var < rule->varCount; var++)
+                {
+                    count += (count == potentialSub);
+                    assignement[var] = satisfied[0][count];
+                    count++;
+                }
+                //If the assignement is valid
+                //Update Knowledge Base
+                foundNovelSolution |= applyRule(rule, kb, assignement, value, verbose, changedWords, contradiction); //If some novel information was added
+            }
+        }
+    }
+    else
+    {
+        for (int potentialSub = 0; potentialSub < lengths[0]; potentialSub++)
+        {
+            for (int var = 0; var < rule->varCount; var++)
+            {
+                assignement[var] = satisfied[var][potentialSub];
+            }
+            //If the assignement is valid
+            //Update Knowledge Base
+            foundNovelSolution |= applyRule(rule, kb, assignement, value, verbose, changedWords, contradiction); //If some novel information was added
+        }
+    }
+    return foundNovelSolution;
+}
+
+/**
+ * satisfiesTemplateRule() - check the rules a template stands for
+ * each value is checked with the static words and the parametric words of that value
+ * 
+ * @rule the template rule
+ * @kb the knowledge base
+ * @values the values to check (one bit per value)
+ * @verbose print out information
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * @contradiction OUTPUTS set to TRUE if a contradiction was added
+ * 
+ * @return TRUE if a novel solution is found
+*/
+static int satisfiesTemplateRule(Rule* rule, KnowledgeBase* kb, unsigned int values, int verbose, long changedWords[NUM_SETS], int* contradiction)
 {
-    //Store arrays of possible var substittutions
     int satisfied[MAX_VARS_IN_RULE][MAX_SET_ELEMENTS];
     int lengths[MAX_VARS_IN_RULE];
 
-    //Store array of potential assignement
-    int assignement[MAX_VARS_IN_RULE];
+    //Only the values whose words changed are checked (there are at most MAX_SET_ELEMENTS)
+    values &= (1U << rule->numParamValues) - 1;
+
+    int foundNovelSolution = 0;
+    for (; values != 0; values &= values - 1)
+    {
+        int value = __builtin_ctz(values);
+        if (rule->words[rule->paramStart + value].mask == 0) continue; //No rule for this value
+        if (findPossibleSubstitutions(rule, kb, satisfied, lengths, value) == 0) continue;
+
+        if (rule->LHSSymmetric) foundNovelSolution |= applySymmetricAssignments(rule, kb, satisfied, lengths, value, verbose, changedWords, contradiction);
+        else foundNovelSolution |= applyAllAssignments(rule, kb, satisfied, lengths, value, verbose, changedWords, contradiction);
+    }
+    return foundNovelSolution;
+}
+
+/**
+ * satisfiesCountingRule() - check a counting rule by counting its functions known true and known false
+ * once maxCount are true the rest are false, once only minCount can be true they all are
+ * (if the count is already broken every function is set both ways so the contradiction is found)
+ * 
+ * @rule the counting rule
+ * @kb the knowledge base
+ * @verbose print out information
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * @contradiction OUTPUTS set to TRUE if a contradiction was added
+ * 
+ * @return TRUE if a novel solution is found
+*/
+static int satisfiesCountingRule(Rule* rule, KnowledgeBase* kb, int verbose, long changedWords[NUM_SETS], int* contradiction)
+{
+    int set = rule->countedFromSet;
+    long* knowledge = &kb->KNOWLEDGE_BASE[set][0][0];
+    RuleWord* counted = &rule->words[rule->countedStart];
+
+    int numTrue = 0;
+    int numFalse = 0;
+    for (int i = 0; i < 2*rule->numCounted; i += 2)
+    {
+        numTrue += (knowledge[counted[i].index] & counted[i].mask) != 0;
+        numFalse += (knowledge[counted[i+1].index] & counted[i+1].mask) != 0;
+    }
+    int numPossible = rule->numCounted - numFalse;
+
+    int foundNovelSolution = 0;
+    for (int i = 0; i < 2*rule->numCounted; i += 2)
+    {
+        int isTrue = (knowledge[counted[i].index] & counted[i].mask) != 0;
+        int isFalse = (knowledge[counted[i+1].index] & counted[i+1].mask) != 0;
+        if (numTrue > rule->maxCount || (numTrue == rule->maxCount && !isTrue))
+        { //No more can be true
+            RuleWord* word = &counted[i+1];
+            foundNovelSolution |= applyResultWord(kb, set, word->index / FUNCTION_RESULT_SIZE, word->index % FUNCTION_RESULT_SIZE, word->mask, changedWords, contradiction);
+        }
+        if (numPossible < rule->minCount || (numPossible == rule->minCount && !isFalse))
+        { //Every one left must be true
+            RuleWord* word = &counted[i];
+            foundNovelSolution |= applyResultWord(kb, set, word->index / FUNCTION_RESULT_SIZE, word->index % FUNCTION_RESULT_SIZE, word->mask, changedWords, contradiction);
+        }
+    }
+    if (foundNovelSolution && verbose) printRule(rule, kb);
+    return foundNovelSolution;
+}
+
+/**
+ * satisfiesRuleTracked() - check if a knowledge base satisfies a rules LHS in a novel way
+ * if it is add novel information to the KB
+ * 
+ * A novel solution is descibed as
+ * 
+ * X AND Y AND Z AND ... => A
+ * 
+ * WHERE KB already knows X,Y,Z,... but does NOT know A (so it's novel)
+ * 
+ * NOTE: this is used for optimisations with how many implication rounds to run when infering facts
+ * 
+ * @rule the rule to check if the LHS is satsified
+ * @kb the knowledge base
+ * @values the values of a template to check (ALL_PARAM_VALUES for every one, ignored by other rules)
+ * @verbose print out information
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * @contradiction OUTPUTS set to TRUE if a contradiction was added
+ * 
+ * @return TRUE if a novel solution is found
+*/
+static int satisfiesRuleTracked(Rule* rule, KnowledgeBase* kb, unsigned int values, int verbose, long changedWords[NUM_SETS], int* contradiction)
+{
+    //Store arrays of possible var substittutions
+    int satisfied[MAX_VARS_IN_RULE][MAX_SET_ELEMENTS];
+    int lengths[MAX_VARS_IN_RULE];
 
     //Stores if any novel solution has been found
     int foundNovelSolution = 0;
 
+    //Templates are checked once per value of their parameter
+    if (rule->numParamValues > 0) return satisfiesTemplateRule(rule, kb, values, verbose, changedWords, contradiction);
+
     //Find possible substitutions for variable elements
     //ALSO: Check if there are trivial ways of showing no solutions to the rule
     //If there is trivially no solution exit function early
-    if (findPossibleSubstitutions(rule, kb, satisfied, lengths) == 0) return 0;
+    if (findPossibleSubstitutions(rule, kb, satisfied, lengths, -1) == 0) return 0;
     
+    //Counting rules only use their conditions as a guard
+    if (rule->numCounted > 0) return satisfiesCountingRule(rule, kb, verbose, changedWords, contradiction);
 
     //If it satifies the rule continue by iterating 
     if (rule->LHSSymmetric)
     { //If it is symmetric and independant we done
-        //Test If Assignement is valid
-        if (rule->varsMutuallyExclusive)
+        foundNovelSolution |= applySymmetricAssignments(rule, kb, satisfied, lengths, -1, verbose, changedWords, contradiction);
+    }
+    else
+    { //If not symmetric and independant we need to permute it
+        foundNovelSolution |= applyAllAssignments(rule, kb, satisfied, lengths, -1, verbose, changedWords, contradiction);
+    }
+    return foundNovelSolution;
+}
+
+/**
+ * satisfiesRule() - check if a knowledge base satisfies a rules LHS in a novel way
+ * if it is add novel information to the KB
+ * 
+ * @rule the rule to check if the LHS is satsified
+ * @kb the knowledge base
+ * @verbose print out information
+ * 
+ * @return TRUE if a novel solution is found
+*/
+int satisfiesRule(Rule* rule, KnowledgeBase* kb, int verbose)
+{
+    int contradiction = 0;
+    return satisfiesRuleTracked(rule, kb, ALL_PARAM_VALUES, verbose, NULL, &contradiction);
+}
+
+/*
+ * State of groundRule() while it assigns elements to the variables of a rule for one parameter value
+*/
+typedef struct
+{
+    Rule* rule;
+    KnowledgeBase* kb;
+    int value; //Parameter value of a template (-1 if not a template)
+    int paramFrom[MAX_VARS_IN_RULE]; //Parametric condition words of each variable for the value
+    int paramTo[MAX_VARS_IN_RULE];
+    int sameAs[MAX_VARS_IN_RULE]; //Earlier variable with identical conditions whose element must not be larger (-1 if none)
+    int candidates[MAX_VARS_IN_RULE][MAX_SET_ELEMENTS]; //Elements each variable can be
+    int numCandidates[MAX_VARS_IN_RULE];
+    int assignement[MAX_VARS_IN_RULE];
+
+    long numInstances;
+    long maxInstances;
+    void (*emit)(void* arg, GroundRule* ground); //NULL while only counting the instances
+    void* arg;
+    GroundRule ground;
+} GroundRuleSearch;
+
+/**
+ * isAnyNegationKnown() - check if the negation of any function in a word of a rule is known
+ * 
+ * @knowledge the words of the element
+ * @word the word of the rule (its index is the word of the element)
+ * 
+ * @return TRUE if some function of the word is known false
+*/
+static inline int isAnyNegationKnown(long* knowledge, RuleWord* word)
+{
+    //Functions and their negation are neighbouring bits, swap each pair to get the negations
+    unsigned long mask = (unsigned long) word->mask;
+    unsigned long negations = ((mask & 0x5555555555555555UL) << 1) | ((mask >> 1) & 0x5555555555555555UL);
+    return (knowledge[word->index % FUNCTION_RESULT_SIZE] & negations) != 0;
+}
+
+/**
+ * canElementSatisfyVar() - check that none of a variable's conditions are known false for an element
+ * 
+ * @search the grounding search
+ * @var the variable
+ * @element the element
+ * 
+ * @return TRUE if the element may satisfy the conditions
+*/
+static int canElementSatisfyVar(GroundRuleSearch* search, int var, int element)
+{
+    Rule* rule = search->rule;
+    long* knowledge = search->kb->KNOWLEDGE_BASE[rule->varConditionFromSet[var]][element];
+    for (int i = rule->varConditionStart[var]; i < rule->varConditionStart[var+1]; i++)
+    {
+        if (isAnyNegationKnown(knowledge, &rule->words[i])) return 0;
+    }
+    for (int i = search->paramFrom[var]; i < search->paramTo[var]; i++)
+    {
+        if (isAnyNegationKnown(knowledge, &rule->words[i])) return 0;
+    }
+    return 1;
+}
+
+/**
+ * haveSameWords() - check if two runs of rule words are the same (ignoring the slot of parametric words)
+ * 
+ * @rule the rule
+ * @fromA @toA the first run
+ * @fromB @toB the second run
+ * 
+ * @return TRUE if they are the same
+*/
+static int haveSameWords(Rule* rule, int fromA, int toA, int fromB, int toB)
+{
+    if (toA - fromA != toB - fromB) return 0;
+    for (int i = 0; i < toA - fromA; i++)
+    {
+        RuleWord* a = &rule->words[fromA + i];
+        RuleWord* b = &rule->words[fromB + i];
+        if (a->index % FUNCTION_RESULT_SIZE != b->index % FUNCTION_RESULT_SIZE || a->mask != b->mask) return 0;
+    }
+    return 1;
+}
+
+/**
+ * isInterchangeableVar() - check if permuting a variable with another gives the same instances
+ * 
+ * @search the grounding search
+ * @var the variable
+ * @other an earlier variable
+ * @forced the forced substitution of each variable
+ * 
+ * @return TRUE if the variables can only be assigned in order
+*/
+static int isInterchangeableVar(GroundRuleSearch* search, int var, int other, int forced[MAX_VARS_IN_RULE])
+{
+    Rule* rule = search->rule;
+    if (forced[var] != -1 || forced[other] != -1) return 0;
+    if (rule->resultVarName == var || rule->resultVarName == other) return 0;
+    if (rule->varConditionFromSet[var] != rule->varConditionFromSet[other]) return 0;
+    return haveSameWords(rule, rule->varConditionStart[var], rule->varConditionStart[var+1], rule->varConditionStart[other], rule->varConditionStart[other+1]) &&
+        haveSameWords(rule, search->paramFrom[var], search->paramTo[var], search->paramFrom[other], search->paramTo[other]);
+}
+
+/**
+ * addGroundLiterals() - add the functions of a rule word to the literals of a ground rule
+ * 
+ * @literals the literals to add to
+ * @numLiterals the number of literals, updated
+ * @set the set of the element
+ * @element the element
+ * @word the word of the element
+ * @mask the functions in the word
+*/
+static void addGroundLiterals(int literals[MAX_GROUND_LITERALS], int* numLiterals, int set, int element, int word, long mask)
+{
+    unsigned long bits = (unsigned long) mask;
+    while (bits != 0)
+    {
+        int bit = __builtin_ctzl(bits);
+        bits &= bits - 1;
+        if (*numLiterals >= MAX_GROUND_LITERALS)
         {
-            if (lengths[0] < rule->varCount) //Only check first variable lengths[0] as symmetric so lengths[0]==lengths[i] for all i
-            { //Lengths < rule->varCount   ---> no valid substitutions
-            }
-            else if (lengths[0] == rule->varCount)
-            { //Lengths == rule->varCount   ---> One valid substitution
-                for (int var = 0; var < rule->varCount; var++)
+            printf("GROUND RULE TOO LARGE!\n");
+            exit(1);
+        }
+        literals[*numLiterals] = FUNCTION_LITERAL(set, element, word*INT_LENGTH + bit);
+        *numLiterals += 1;
+    }
+}
+
+/**
+ * addGroundResults() - add the results of a rule for one element to its ground instance
+ * 
+ * @search the grounding search
+ * @element the element the result is for
+ * 
+ * @return TRUE if some of the results are not known yet
+*/
+static int addGroundResults(GroundRuleSearch* search, int element)
+{
+    Rule* rule = search->rule;
+    GroundRule* ground = &search->ground;
+    int set = rule->resultFromSet;
+    long* knowledge = search->kb->KNOWLEDGE_BASE[set][element];
+
+    int unknown = 0;
+    for (int r = rule->resultStart; r < rule->numWords; r++)
+    {
+        addGroundLiterals(ground->results, &ground->numResults, set, element, rule->words[r].index, rule->words[r].mask);
+        unknown |= (knowledge[rule->words[r].index] & rule->words[r].mask) != rule->words[r].mask;
+    }
+    if (search->value < 0) return unknown;
+
+    for (int value = 0; value < rule->numParamValues; value++)
+    {
+        int slot = (value == search->value) ? PARAM_RESULT_SLOT : PARAM_OTHER_RESULT_SLOT;
+        if (slot == PARAM_OTHER_RESULT_SLOT && !rule->paramOtherResults) continue;
+        for (int r = getParamStart(rule, value); r < getParamEnd(rule, value); r++)
+        {
+            if (rule->words[r].index / FUNCTION_RESULT_SIZE != slot) continue;
+            int word = rule->words[r].index % FUNCTION_RESULT_SIZE;
+            addGroundLiterals(ground->results, &ground->numResults, set, element, word, rule->words[r].mask);
+            unknown |= (knowledge[word] & rule->words[r].mask) != rule->words[r].mask;
+        }
+    }
+    return unknown;
+}
+
+/**
+ * emitGroundInstance() - build the instance of the rule for the assigned variables and pass it on
+ * 
+ * @search the grounding search
+*/
+static void emitGroundInstance(GroundRuleSearch* search)
+{
+    Rule* rule = search->rule;
+    GroundRule* ground = &search->ground;
+    int* assignement = search->assignement;
+    if (rule->varsMutuallyExclusive && isRepeatVar(assignement, rule->varCount)) return;
+
+    ground->numResults = 0;
+    ground->isCounting = rule->numCounted > 0;
+    if (ground->isCounting)
+    {
+        ground->minCount = rule->minCount;
+        ground->maxCount = rule->maxCount;
+        for (int i = rule->countedStart; i < rule->countedStart + 2*rule->numCounted; i++)
+        { //Each counted function then the function known when it is false
+            RuleWord* counted = &rule->words[i];
+            addGroundLiterals(ground->results, &ground->numResults, rule->countedFromSet, 
+                counted->index / FUNCTION_RESULT_SIZE, counted->index % FUNCTION_RESULT_SIZE, counted->mask);
+        }
+    }
+    else
+    {
+        //Same elements as applyRule()
+        int unknown = 0;
+        if (rule->resultVarName >= 0)
+        {
+            unknown |= addGroundResults(search, assignement[rule->resultVarName]);
+        }
+        else if (rule->resultVarName == -1)
+        {
+            for (int setElement = 0; setElement < search->kb->SET_SIZES[rule->resultFromSet]; setElement++)
+            {
+                int inAssignment = 0;
+                for (int i = 0; i < rule->varCount; i++)
                 {
-                    assignement[var] = satisfied[var][var];
+                    if (assignement[i] == setElement && rule->varConditionFromSet[i] == rule->resultFromSet) inAssignment = 1;
                 }
-                //If the assignement is valid
-                //Update Knowledge Base
-                foundNovelSolution |= applyRule(rule, kb, assignement, verbose); //If some novel information was added
+                if (inAssignment == 0) unknown |= addGroundResults(search, setElement);
             }
-            else
-            { //Lengths > rule->varCount   ---> Multiple valid substitutions
-                for (int potentialSub = 0; potentialSub < lengths[0]; potentialSub++)
-                { //Use potential sub as the variable to ignore
-                    int count = 0;
-                    for (int var = 0; var < rule->varCount; var++)
-                    {
-                        count += (count == potentialSub);
-                        assignement[var] = satisfied[0][count];
-                        count++;
-                    }
-                    //If the assignement is valid
-                    //Update Knowledge Base
-                    foundNovelSolution |= applyRule(rule, kb, assignement, verbose); //If some novel information was added
-                }
+        }
+        else if (rule->resultVarName <= -1000)
+        {
+            unknown |= addGroundResults(search, (-rule->resultVarName)-1000);
+        }
+        if (!unknown) return; //Nothing left for it to find
+    }
+
+    search->numInstances++;
+    if (search->emit == NULL) return;
+
+    ground->numConditions = 0;
+    for (int var = 0; var < rule->varCount; var++)
+    {
+        int set = rule->varConditionFromSet[var];
+        for (int i = rule->varConditionStart[var]; i < rule->varConditionStart[var+1]; i++)
+        {
+            addGroundLiterals(ground->conditions, &ground->numConditions, set, assignement[var], rule->words[i].index, rule->words[i].mask);
+        }
+        for (int i = search->paramFrom[var]; i < search->paramTo[var]; i++)
+        {
+            addGroundLiterals(ground->conditions, &ground->numConditions, set, assignement[var], rule->words[i].index % FUNCTION_RESULT_SIZE, rule->words[i].mask);
+        }
+    }
+    search->emit(search->arg, ground);
+}
+
+/**
+ * groundVars() - assign every candidate element to a variable then move on to the next
+ * 
+ * @search the grounding search
+ * @var the variable to assign
+*/
+static void groundVars(GroundRuleSearch* search, int var)
+{
+    if (search->numInstances > search->maxInstances) return;
+    if (var == search->rule->varCount)
+    {
+        emitGroundInstance(search);
+        return;
+    }
+
+    int same = search->sameAs[var];
+    for (int i = 0; i < search->numCandidates[var]; i++)
+    {
+        int element = search->candidates[var][i];
+        if (same != -1)
+        { //Only one order of interchangeable variables
+            if (element < search->assignement[same]) continue;
+            if (element == search->assignement[same] && search->rule->varsMutuallyExclusive) continue;
+        }
+        search->assignement[var] = element;
+        groundVars(search, var+1);
+    }
+}
+
+/**
+ * groundRuleValue() - list the instances of a rule for one parameter value
+ * 
+ * @search the grounding search, with the rule, kb and value set
+*/
+static void groundRuleValue(GroundRuleSearch* search)
+{
+    Rule* rule = search->rule;
+    int value = search->value;
+
+    //The words of a value are in slot order so each var's are a contiguous run
+    int paramTo = (value >= 0) ? getParamStart(rule, value) : 0;
+    int paramEnd = (value >= 0) ? getParamEnd(rule, value) : 0;
+    int forced[MAX_VARS_IN_RULE];
+    for (int var = 0; var < rule->varCount; var++)
+    {
+        search->paramFrom[var] = paramTo;
+        while (paramTo < paramEnd && rule->words[paramTo].index / FUNCTION_RESULT_SIZE == var) paramTo++;
+        search->paramTo[var] = paramTo;
+        forced[var] = (value >= 0 && var == rule->paramVar) ? value : rule->varsForcedSubstitutions[var];
+    }
+
+    for (int var = 0; var < rule->varCount; var++)
+    {
+        search->numCandidates[var] = 0;
+        int set = rule->varConditionFromSet[var];
+        for (int element = 0; element < search->kb->SET_SIZES[set]; element++)
+        {
+            if (forced[var] != -1 && element != forced[var]) continue;
+            if (canElementSatisfyVar(search, var, element))
+            {
+                search->candidates[var][search->numCandidates[var]] = element;
+                search->numCandidates[var]++;
             }
         }
-        else
+        if (search->numCandidates[var] == 0) return; //The rule can never apply
+
+        search->sameAs[var] = -1;
+        for (int other = var-1; other >= 0; other--)
         {
-            for (int potentialSub = 0; potentialSub < lengths[0]; potentialSub++)
+            if (isInterchangeableVar(search, var, other, forced))
             {
-                for (int var = 0; var < rule->varCount; var++)
+                search->sameAs[var] = other;
+                break;
+            }
+        }
+    }
+    groundVars(search, 0);
+}
+
+/**
+ * groundRuleSearch() - run a grounding search over every parameter value of a rule
+ * 
+ * @search the grounding search, with the rule, kb and emit set
+*/
+static void groundRuleSearch(GroundRuleSearch* search)
+{
+    Rule* rule = search->rule;
+    search->numInstances = 0;
+    if (rule->numParamValues == 0)
+    {
+        search->value = -1;
+        groundRuleValue(search);
+        return;
+    }
+    for (int value = 0; value < rule->numParamValues; value++)
+    {
+        if (rule->words[rule->paramStart + value].mask == 0) continue; //No rule for this value
+        search->value = value;
+        groundRuleValue(search);
+    }
+}
+
+/**
+ * groundRule() - list the instances of a rule, one for each way to assign elements to its variables
+ * instances that can never apply in kb are skipped (a condition is known false or every result is known true)
+ * variables with identical conditions that the result doesn't name are assigned in increasing order
+ * as permuting them gives the same instance
+ * 
+ * @rule the rule to ground
+ * @kb the knowledge base the instances are for
+ * @maxInstances the most instances to list
+ * @emit called with each instance
+ * @arg passed to emit
+ * 
+ * @return the number of instances, or -1 if there are more than maxInstances (then none are emitted)
+*/
+long groundRule(Rule* rule, KnowledgeBase* kb, long maxInstances, void (*emit)(void* arg, GroundRule* ground), void* arg)
+{
+    GroundRuleSearch* search = (GroundRuleSearch*) malloc(sizeof(GroundRuleSearch));
+    if (search == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    search->rule = rule;
+    search->kb = kb;
+    search->maxInstances = maxInstances;
+    search->arg = arg;
+
+    //Count first so a rule with too many instances emits none
+    search->emit = NULL;
+    groundRuleSearch(search);
+    long numInstances = search->numInstances;
+    if (numInstances <= maxInstances)
+    {
+        search->emit = emit;
+        groundRuleSearch(search);
+    }
+    free(search);
+    return numInstances <= maxInstances ? numInstances : -1;
+}
+
+/**
+ * queueWatchers() - queue every active rule watching the changed words
+ * rules after the current rule are checked this round, the rest are checked next round
+ * 
+ * @rs the set of rules
+ * @changedWords the words changed in the knowledge base
+ * @currentRule the rule being checked (-1 to queue everything for this round)
+ * @queued the rules to check this round
+ * @queuedValues the values of each template to check this round
+ * @nextQueued the rules to check next round
+ * @nextQueuedValues the values of each template to check next round
+*/
+static void queueWatchers(RuleSet* rs, long changedWords[NUM_SETS], int currentRule, unsigned long queued[], unsigned int queuedValues[], unsigned long nextQueued[], unsigned int nextQueuedValues[])
+{
+    for (int set = 0; set < NUM_SETS; set++)
+    {
+        long words = changedWords[set];
+        while (words != 0)
+        {
+            int i = __builtin_ctzl(words);
+            words &= words - 1;
+
+            for (int w = 0; w < rs->NUM_WATCHERS[set][i]; w++)
+            {
+                int ruleID = rs->WATCHERS[set][i][w];
+                if (rs->RULE_ACTIVE[ruleID] == 0) continue;
+
+                unsigned long mask = 1UL << (ruleID % INT_LENGTH);
+                if (ruleID > currentRule)
                 {
-                    assignement[var] = satisfied[var][potentialSub];
+                    queued[ruleID / INT_LENGTH] |= mask;
+                    queuedValues[ruleID] |= rs->WATCHER_VALUES[set][i][w];
+                }
+                else
+                {
+                    nextQueued[ruleID / INT_LENGTH] |= mask;
+                    nextQueuedValues[ruleID] |= rs->WATCHER_VALUES[set][i][w];
                 }
-                //If the assignement is valid
-                //Update Knowledge Base
-                foundNovelSolution |= applyRule(rule, kb, assignement, verbose); //If some novel information was added
             }
         }
-        
     }
-    else
-    { //If not symmetric and independant we need to permute it
-        //Figure out how many combinations we have
-        long numCombinations = 1;
-        for (int var = 0; var < rule->varCount; var++) numCombinations *= lengths[var];
+}
 
-        for(long count = 0; count < numCombinations; count++)
+/**
+ * runRuleWorklist() - check queued rules in order for a number of rounds
+ * every rule that adds information queues the rules watching the words it changed
+ * 
+ * @rs the set of rules
+ * @kb the knowledge base
+ * @queued the rules to check in the first round
+ * @queuedValues the values of each template to check in the first round (0 for rules not queued)
+ * @changedWords OUTPUTS the words changed in the last round that was run
+ * @numRounds the maximium number of rounds to run
+ * @verbose print discoveries
+ * 
+ * NOTE: only the words rules change are checked for contradictions, the knowledge base must start without any
+ * 
+ * @return 1 if a novel solution is found, -1 if a contradiction is found, 0 otherwise
+*/
+static int runRuleWorklist(RuleSet* rs, KnowledgeBase* kb, unsigned long queued[], unsigned int queuedValues[], long changedWords[NUM_SETS], int numRounds, int verbose)
+{
+    const int QUEUE_WORDS = (rs->NUM_RULES + INT_LENGTH - 1) / INT_LENGTH;
+    unsigned long nextQueued[QUEUE_WORDS > 0 ? QUEUE_WORDS : 1];
+    unsigned int nextQueuedValues[rs->NUM_RULES > 0 ? rs->NUM_RULES : 1];
+    memset(nextQueuedValues, 0, sizeof(unsigned int)*rs->NUM_RULES);
+
+    int foundNovelSolution = 0;
+    for (int round = 0; round < numRounds; round++)
+    {
+        memset(nextQueued, 0, sizeof(unsigned long)*QUEUE_WORDS);
+        for (int set = 0; set < NUM_SETS; set++) changedWords[set] = 0;
+
+        int roundNovelSolution = 0;
+        for (int q = 0; q < QUEUE_WORDS; q++)
         {
-            //Generate Assignement
-            getAssignment(satisfied, lengths, assignement, count);
+            //Rules can be queued into this word while it is being read
+            while (queued[q] != 0)
+            {
+                int ruleID = q*INT_LENGTH + __builtin_ctzl(queued[q]);
+                queued[q] &= queued[q] - 1;
 
-            if (!rule->varsMutuallyExclusive || !isRepeatVar(assignement, rule->varCount))
-            { //If the assignement is valid
-                //Update Knowledge Base
-                foundNovelSolution |= applyRule(rule, kb, assignement, verbose); //If some novel information was added
+                unsigned int values = queuedValues[ruleID];
+                queuedValues[ruleID] = 0;
+
+                long ruleChangedWords[NUM_SETS] = {0};
+                int contradiction = 0;
+                if (satisfiesRuleTracked(getRule(rs, ruleID), kb, values, verbose, ruleChangedWords, &contradiction))
+                {
+                    roundNovelSolution = 1;
+                    if (contradiction) return -1;
+
+                    queueWatchers(rs, ruleChangedWords, ruleID, queued, queuedValues, nextQueued, nextQueuedValues);
+                    for (int set = 0; set < NUM_SETS; set++) changedWords[set] |= ruleChangedWords[set];
+                }
             }
         }
+        foundNovelSolution |= roundNovelSolution;
+        if (roundNovelSolution == 0) break; //Nothing left to find
+
+        //Every rule queued this round has been checked so its values are all 0
+        memcpy(queued, nextQueued, sizeof(unsigned long)*QUEUE_WORDS);
+        memcpy(queuedValues, nextQueuedValues, sizeof(unsigned int)*rs->NUM_RULES);
+        memset(nextQueuedValues, 0, sizeof(unsigned int)*rs->NUM_RULES);
     }
     return foundNovelSolution;
 }
@@ -867,21 +2378,115 @@ int satisfiesRule(Rule* rule, KnowledgeBase* kb, int verbose)
  * @rs the set of rules
  * @kb the knowledge base
  * @verbose print discoveries
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
+ * 
+ * NOTE: only contradictions in the words rules change are found, check hasExplicitContradiction() first
  * 
  * @return 1 if a novel solution is found, -1 if a contradiction is found, 0 otherwise
 */
-int inferknowledgeBaseFromRules(RuleSet* rs, KnowledgeBase* kb, int verbose)
+int inferknowledgeBaseFromRules(RuleSet* rs, KnowledgeBase* kb, int verbose, long changedWords[NUM_SETS])
 {
-    int foundNovelSolution = 0;
+    const int QUEUE_WORDS = (rs->NUM_RULES + INT_LENGTH - 1) / INT_LENGTH;
+    unsigned long queued[QUEUE_WORDS > 0 ? QUEUE_WORDS : 1];
+    unsigned int queuedValues[rs->NUM_RULES > 0 ? rs->NUM_RULES : 1];
+    memset(queued, 0, sizeof(unsigned long)*QUEUE_WORDS);
+
+    //Check every active rule
     for (int i = 0; i < rs->NUM_RULES; i++)
     {
-        if (rs->RULE_ACTIVE[i])
-        { //Only apply a rule if it hasn't been culled
-            foundNovelSolution |= satisfiesRule(rs->RULES[i], kb, verbose);
-            if (foundNovelSolution && hasExplicitContradiction(kb)) return -1;
-        }
+        queuedValues[i] = 0;
+        if (rs->RULE_ACTIVE[i] == 0) continue;
+        queued[i / INT_LENGTH] |= 1UL << (i % INT_LENGTH);
+        queuedValues[i] = ALL_PARAM_VALUES;
     }
-    return foundNovelSolution;
+
+    long roundChangedWords[NUM_SETS];
+    int result = runRuleWorklist(rs, kb, queued, queuedValues, roundChangedWords, 1, verbose);
+    if (changedWords != NULL)
+    {
+        for (int set = 0; set < NUM_SETS; set++) changedWords[set] |= roundChangedWords[set];
+    }
+    return result;
+}
+
+/**
+ * inferknowledgeBaseFromRulesIncremental() - worklist version of inferknowledgeBaseFromRules()
+ * only rules watching a changed word are checked, any words they change queue their watchers in turn
+ * 
+ * NOTE: gives the same results as repeatedly calling inferknowledgeBaseFromRules() 
+ * as long as the knowledge base was already fully infered before changedWords were modified
+ * 
+ * @rs the set of rules
+ * @kb the knowledge base
+ * @changedWords the words changed since the last inference, updated with the words still changed when rounds run out
+ * @numRounds the maximium number of rounds to run
+ * @verbose print discoveries
+ * 
+ * @return 1 if a novel solution is found, -1 if a contradiction is found, 0 otherwise
+*/
+int inferknowledgeBaseFromRulesIncremental(RuleSet* rs, KnowledgeBase* kb, long changedWords[NUM_SETS], int numRounds, int verbose)
+{
+    const int QUEUE_WORDS = (rs->NUM_RULES + INT_LENGTH - 1) / INT_LENGTH;
+    unsigned long queued[QUEUE_WORDS > 0 ? QUEUE_WORDS : 1];
+    unsigned long unused[QUEUE_WORDS > 0 ? QUEUE_WORDS : 1];
+    unsigned int queuedValues[rs->NUM_RULES > 0 ? rs->NUM_RULES : 1];
+    unsigned int unusedValues[rs->NUM_RULES > 0 ? rs->NUM_RULES : 1];
+    memset(queued, 0, sizeof(unsigned long)*QUEUE_WORDS);
+    memset(queuedValues, 0, sizeof(unsigned int)*rs->NUM_RULES);
+
+    //Queue everything watching the changed words for the first round
+    queueWatchers(rs, changedWords, -1, queued, queuedValues, unused, unusedValues);
+
+    return runRuleWorklist(rs, kb, queued, queuedValues, changedWords, numRounds, verbose);
+}
+
+/**
+ * inferknowledgeBaseFromNewRules() - inferknowledgeBaseFromRulesIncremental() for a knowledge base infered before
+ * some rules were added, the new rules are checked along with the rules watching the changed words
+ * 
+ * @rs the set of rules
+ * @kb the knowledge base
+ * @changedWords the words changed since the last inference, updated with the words still changed when rounds run out
+ * @firstNewRule the first rule the knowledge base hasn't been infered with
+ * @numRounds the maximium number of rounds to run
+ * @verbose print discoveries
+ * 
+ * @return 1 if a novel solution is found, -1 if a contradiction is found, 0 otherwise
+*/
+int inferknowledgeBaseFromNewRules(RuleSet* rs, KnowledgeBase* kb, long changedWords[NUM_SETS], int firstNewRule, int numRounds, int verbose)
+{
+    const int QUEUE_WORDS = (rs->NUM_RULES + INT_LENGTH - 1) / INT_LENGTH;
+    unsigned long queued[QUEUE_WORDS > 0 ? QUEUE_WORDS : 1];
+    unsigned long unused[QUEUE_WORDS > 0 ? QUEUE_WORDS : 1];
+    unsigned int queuedValues[rs->NUM_RULES > 0 ? rs->NUM_RULES : 1];
+    unsigned int unusedValues[rs->NUM_RULES > 0 ? rs->NUM_RULES : 1];
+    memset(queued, 0, sizeof(unsigned long)*QUEUE_WORDS);
+    memset(queuedValues, 0, sizeof(unsigned int)*rs->NUM_RULES);
+
+    for (int i = firstNewRule; i < rs->NUM_RULES; i++)
+    {
+        if (rs->RULE_ACTIVE[i] == 0) continue;
+        queued[i / INT_LENGTH] |= 1UL << (i % INT_LENGTH);
+        queuedValues[i] = ALL_PARAM_VALUES;
+    }
+    queueWatchers(rs, changedWords, -1, queued, queuedValues, unused, unusedValues);
+
+    return runRuleWorklist(rs, kb, queued, queuedValues, changedWords, numRounds, verbose);
+}
+
+/**
+ * markFunctionChanged() - mark the word holding a function as changed
+ * 
+ * @changedWords the changed words bitstrings to update
+ * @set the setID/index of the function
+ * @function the functionID/index of the function
+*/
+void markFunctionChanged(long changedWords[NUM_SETS], int set, int function)
+{
+    int index, bit;
+    getIndexAndBit(&index, &bit, function);
+
+    changedWords[set] |= 1L << index;
 }
 
 /**
@@ -894,7 +2499,7 @@ void printRules(RuleSet* rs, KnowledgeBase* kb)
 {
     for (int i = 0; i < rs->NUM_RULES; i++)
     {
-        printRule(rs->RULES[i], kb);
+        printRule(getRule(rs, i), kb);
     }
 }
 
@@ -24,9 +24,17 @@
 
 #pragma once
 
+#include <stdatomic.h>
+
 #include "constants.h"
 #include "knowledge.h"
 
+//Slots of the parametric words of a template rule, slots below MAX_VARS_IN_RULE are the conditions of that var
+#define PARAM_RESULT_SLOT MAX_VARS_IN_RULE //Result of the rule for the value
+#define PARAM_OTHER_RESULT_SLOT (MAX_VARS_IN_RULE+1) //Result of the rule for every value but this one
+#define ALL_PARAM_VALUES (~0U) //Every value of a template (one bit per value)
+#define PARAM_SLOTS (MAX_VARS_IN_RULE+2)
+
 typedef struct
 {
     //Meta data
@@ -48,17 +56,135 @@ typedef struct
     long result[FUNCTION_RESULT_SIZE];
     int resultFromSet; 
 
+    //Counting side, used instead of the result when numCounted > 0
+    //between minCount and maxCount of the counted functions are true
+    int minCount;
+    int maxCount;
+    int numCounted;
+    int countedFromSet;
+    int countedElements[MAX_COUNTED_IN_RULE];
+    int countedFunctions[MAX_COUNTED_IN_RULE];
+    int countedNotFunctions[MAX_COUNTED_IN_RULE]; //Function that is known when the counted function is false
+
+    //Template side, used when numParamValues > 0
+    //the rule stands for one rule per value of its parameter (e.g. a night or a player)
+    int numParamValues;
+    int paramVar; //Variable forced to the element equal to the parameter value (-1 if none)
+    long paramWords[MAX_SET_ELEMENTS][PARAM_SLOTS][FUNCTION_RESULT_SIZE]; //Per value: conditions of each var, the result and the result given to every other value
+    int paramMissing[MAX_SET_ELEMENTS]; //Values some parametric function has no instance for
+
     int LHSSymmetric;
+} TempRule;
+
+/*
+ * A non-zero word of a rule, the bits of mask must all be set in word index of the element
+*/
+typedef struct
+{
+    int index;
+    long mask;
+} RuleWord;
+
+/*
+ * A rule compiled from a temp rule, only the non-zero words of the conditions and result are stored
+*/
+typedef struct
+{
+    //Meta data
+    int varsMutuallyExclusive; //Are the variables mutually exclusive
+    int varCount; //How many variables are there in the condition side
+
+    //Condition side of implication
+    int varConditionStart[MAX_VARS_IN_RULE+1]; //Conditions of var are words[varConditionStart[var]] up to words[varConditionStart[var+1]]
+    int varConditionFromSet[MAX_VARS_IN_RULE];
+    int varsForcedSubstitutions[MAX_VARS_IN_RULE]; //If this is used the program wont try and substitue values but instead check if these elements in the set are valid
+
+    //Result side
+    int resultVarName; //Same as TempRule
+    int resultStart; //Result is words[resultStart] up to words[numWords]
+    int resultFromSet; 
+
+    //Counting side (numCounted > 0), the conditions only guard when the count applies
+    int minCount;
+    int maxCount;
+    int numCounted;
+    int countedFromSet;
+    int countedStart; //Counted function i and its negation are words[countedStart+2*i] and words[countedStart+2*i+1]
+                      //their index is element*FUNCTION_RESULT_SIZE + word so they can be on any element of the set
+
+    //Template side (numParamValues > 0), checked once per value with the static words and the words of that value
+    int numParamValues;
+    int paramVar; //Same as TempRule
+    int paramStart; //words[paramStart+value] is a table entry whose index is where the words of value start (mask 0 if value has no instance)
+                    //words[paramStart+numParamValues].index is where they end, their index is slot*FUNCTION_RESULT_SIZE + word
+    int paramOtherResults; //TRUE if some value has words in PARAM_OTHER_RESULT_SLOT
+
+    int LHSSymmetric;
+
+    int numWords;
+    RuleWord words[]; //Condition words of each variable, the counted words, the parametric words then the result words
 } Rule;
 
 typedef struct
 {
-    Rule *RULES[MAX_NUM_RULES];
-    int RULE_ACTIVE[MAX_NUM_RULES];
+    //Compiled rules are stored back to back in one growable arena
+    char *RULE_ARENA;
+    long RULE_ARENA_SIZE;
+    long RULE_ARENA_CAPACITY;
+    long *RULE_OFFSETS; //Where each rule starts in the arena
+    int *RULE_ACTIVE;
     int NUM_RULES;
-    Rule *temp_rule;
+    int RULES_CAPACITY;
+    TempRule *temp_rule;
+
+    //Index of rules watching each (set, word) of the knowledge base
+    //A rule watches every word its LHS conditions read from
+    int *WATCHERS[NUM_SETS][FUNCTION_RESULT_SIZE];
+    unsigned int *WATCHER_VALUES[NUM_SETS][FUNCTION_RESULT_SIZE]; //Values of a template the word is read by (ALL_PARAM_VALUES if not only parametric words)
+    int NUM_WATCHERS[NUM_SETS][FUNCTION_RESULT_SIZE];
+    int WATCHERS_CAPACITY[NUM_SETS][FUNCTION_RESULT_SIZE];
 } RuleSet;
 
+/*
+ * Immutable snapshots of a ruleset so sampler threads can keep inferring while the original is edited
+ * readers pin the current snapshot, replaced snapshots are freed once no reader has them pinned
+ * only one thread may publish
+*/
+typedef struct
+{
+    _Atomic(RuleSet*) CURRENT; //Latest published snapshot
+    _Atomic(RuleSet*) *PINNED; //Snapshot each reader is using
+    int NUM_READERS;
+    RuleSet **RETIRED; //Replaced snapshots that may still be pinned
+    int NUM_RETIRED;
+    int RETIRED_CAPACITY;
+    int VERSION; //Number of snapshots published
+} VersionedRuleSet;
+
+#define MAX_GROUND_LITERALS 1024 //Most literals on either side of a ground rule
+
+/*
+ * One instance of a rule with every variable assigned an element, as function literals (see FUNCTION_LITERAL())
+ * conditions => every result, or for a counting rule conditions => between minCount and maxCount of the counted functions are true
+ * where results[2*i] is counted function i and results[2*i+1] the function known when it is false
+*/
+typedef struct
+{
+    int conditions[MAX_GROUND_LITERALS];
+    int numConditions;
+    int results[MAX_GROUND_LITERALS];
+    int numResults;
+
+    int isCounting;
+    int minCount;
+    int maxCount;
+} GroundRule;
+
+//Changed words are tracked as one bitstring per set (bit i => word i of some element changed)
+#if FUNCTION_RESULT_SIZE > INT_LENGTH
+#error "FUNCTION_RESULT_SIZE must fit in a single changed words bitstring"
+#endif
+
 /**
  * initRS() - initialise the ruleset
  * 
@@ -66,6 +192,50 @@ typedef struct
 */
 RuleSet* initRS();
 
+/**
+ * copyRuleSet() - make a read only copy of a ruleset, the copy has no temp rule so rules can't be pushed to it
+ * 
+ * @ruleSet - the ruleset to copy
+ * 
+ * @return the copy
+*/
+RuleSet* copyRuleSet(RuleSet* ruleSet);
+
+/**
+ * freeRuleSet() - free a ruleset and all its rules
+ * 
+ * @ruleSet - the ruleset to free
+*/
+void freeRuleSet(RuleSet* ruleSet);
+
+/**
+ * initVersionedRuleSet() - create versioned snapshots of a ruleset, publishing its current rules
+ * 
+ * @ruleSet - the ruleset to snapshot (keeps being owned and edited by the caller)
+ * @numReaders - the number of threads that will pin snapshots
+ * 
+ * @return the versioned ruleset
+*/
+VersionedRuleSet* initVersionedRuleSet(RuleSet* ruleSet, int numReaders);
+
+/**
+ * publishRuleSet() - publish a new snapshot of a ruleset, freeing old snapshots no reader has pinned
+ * 
+ * @versions - the versioned ruleset
+ * @ruleSet - the edited ruleset to snapshot
+*/
+void publishRuleSet(VersionedRuleSet* versions, RuleSet* ruleSet);
+
+/**
+ * pinRuleSet() - pin the latest snapshot, it won't be freed until the reader pins another
+ * 
+ * @versions - the versioned ruleset
+ * @reader - the index of the reading thread
+ * 
+ * @return the snapshot (read only)
+*/
+RuleSet* pinRuleSet(VersionedRuleSet* versions, int reader);
+
 /**
  * getNumRules() - gets the number of rules stored
  * 
@@ -81,13 +251,14 @@ int getNumRules(RuleSet* ruleSet);
  * @ruleSet - the ruleset which stores the rules
  * @index - the location of the rule to get
  * 
- * @return the rule at index
+ * @return the rule at index (only valid until the next rule is pushed)
 */
 Rule* getRule(RuleSet* ruleSet, int index);
 
 /**
  * pushTempRule() - tempRule is a working space to build rules quickly
  * temp rule is kindof similar toa  builder pattern
+ * the temp rule is compiled into a rule only storing its non-zero words
  * 
  * @ruleSet - the ruleset to put the temp rule
 */
@@ -164,6 +335,89 @@ void addConditionToTempRuleName(RuleSet* rs, KnowledgeBase* kb, int varName, cha
 */
 void addFixedConditionToTempRuleName(RuleSet* rs, KnowledgeBase* kb, int varName, char* set, char* function, int forcedSubstitution);
 
+/**
+ * setTempRuleCount() - make the temp rule a counting rule
+ * between minCount and maxCount of its counted functions are true (given its conditions are)
+ * 
+ * once maxCount are known true the rest are false, once only minCount can be true they all are
+ * this is checked with two counters rather than trying every assignment of variables
+ * 
+ * @rs the ruleset with the temp rule to set
+ * @minCount the fewest counted functions that can be true
+ * @maxCount the most counted functions that can be true
+*/
+void setTempRuleCount(RuleSet* rs, int minCount, int maxCount);
+
+/**
+ * addCountedToTempRule() - add a function to count to a counting temp rule
+ * 
+ * @rs the ruleset with the temp rule to add to
+ * @set the set of the element (the same for every counted function)
+ * @element the element the function is of
+ * @function the function to count
+ * @notFunction the function known when the counted function is false
+*/
+void addCountedToTempRule(RuleSet* rs, int set, int element, int function, int notFunction);
+
+/**
+ * addCountedToTempRuleName() - 
+ * 
+ * @rs the ruleset with the temp rule to add to
+ * @kb the knowledge base the rule is for
+ * @set the NAME of the set of the element
+ * @element the element the function is of
+ * @function the NAME of the function to count
+ * @notFunction the NAME of the function known when the counted function is false
+*/
+void addCountedToTempRuleName(RuleSet* rs, KnowledgeBase* kb, char* set, int element, char* function, char* notFunction);
+
+/**
+ * setTempRuleTemplate() - make the temp rule a template standing for one rule per value of a parameter
+ * so per night or per player families are stored (and checked) as a single rule
+ * 
+ * @rs the ruleset with the temp rule to set
+ * @numParamValues the number of values of the parameter (at most MAX_SET_ELEMENTS)
+ * @paramVar the variable whose element is the parameter value (-1 if none)
+*/
+void setTempRuleTemplate(RuleSet* rs, int numParamValues, int paramVar);
+
+/**
+ * addParamConditionToTempRuleName() - add a condition whose function depends on the parameter value
+ * a value whose function would be out of range has no instance of the rule
+ * 
+ * @rs the ruleset with the temp rule to add the condition to
+ * @kb the knowledge base the rule is for
+ * @varName the var name on the LHS
+ * @set the NAME of the set of the element of the var
+ * @functionFormat the NAME of the function with a %d for the parameter value
+ * @offset added to the parameter value when writing the name (e.g. 1 for the next night)
+*/
+void addParamConditionToTempRuleName(RuleSet* rs, KnowledgeBase* kb, int varName, char* set, char* functionFormat, int offset);
+
+/**
+ * setParamTempRuleResultName() - add a result whose function depends on the parameter value
+ * 
+ * @rs the ruleset with the temp rule to set the result of
+ * @kb the knowledge base the rule is for
+ * @resultVarName the var name on the RHS
+ * @set the NAME of the set of the element of the var
+ * @functionFormat the NAME of the function with a %d for the parameter value
+ * @offset added to the parameter value when writing the name
+*/
+void setParamTempRuleResultName(RuleSet* rs, KnowledgeBase* kb, int resultVarName, char* set, char* functionFormat, int offset);
+
+/**
+ * setOtherParamTempRuleResultName() - add a result of the function for every parameter value except the rules own
+ * e.g. killing player X means not killing any other player
+ * 
+ * @rs the ruleset with the temp rule to set the result of
+ * @kb the knowledge base the rule is for
+ * @resultVarName the var name on the RHS
+ * @set the NAME of the set of the element of the var
+ * @functionFormat the NAME of the function with a %d for the parameter value
+*/
+void setOtherParamTempRuleResultName(RuleSet* rs, KnowledgeBase* kb, int resultVarName, char* set, char* functionFormat);
+
 /**
  * optimiseRuleset() - optimise the ruleset by seeing how many rules can be disabled
  * due to lack of novel information they will provide
@@ -221,6 +475,22 @@ void printRules(RuleSet* rs, KnowledgeBase* kb);
 */
 int satisfiesRule(Rule* rule, KnowledgeBase* kb, int verbose);
 
+/**
+ * groundRule() - list the instances of a rule, one for each way to assign elements to its variables
+ * instances that can never apply in kb are skipped (a condition is known false or every result is known true)
+ * variables with identical conditions that the result doesn't name are assigned in increasing order
+ * as permuting them gives the same instance
+ * 
+ * @rule the rule to ground
+ * @kb the knowledge base the instances are for
+ * @maxInstances the most instances to list
+ * @emit called with each instance
+ * @arg passed to emit
+ * 
+ * @return the number of instances, or -1 if there are more than maxInstances (then none are emitted)
+*/
+long groundRule(Rule* rule, KnowledgeBase* kb, long maxInstances, void (*emit)(void* arg, GroundRule* ground), void* arg);
+
 /**
  * inferknowledgeBaseFromRules() - For all rules in a ruleset 
  * check if any novel information can be infered
@@ -228,7 +498,51 @@ int satisfiesRule(Rule* rule, KnowledgeBase* kb, int verbose);
  * @rs the set of rules
  * @kb the knowledge base
  * @verbose print discoveries
+ * @changedWords OUTPUTS the words changed in the knowledge base (can be NULL)
  * 
- * @return TRUE if a novel solution is found
+ * NOTE: only contradictions in the words rules change are found, check hasExplicitContradiction() first
+ * 
+ * @return 1 if a novel solution is found, -1 if a contradiction is found, 0 otherwise
+*/
+int inferknowledgeBaseFromRules(RuleSet* rs, KnowledgeBase* kb, int verbose, long changedWords[NUM_SETS]);
+
+/**
+ * inferknowledgeBaseFromRulesIncremental() - worklist version of inferknowledgeBaseFromRules()
+ * only rules watching a changed word are checked, any words they change queue their watchers in turn
+ * 
+ * NOTE: gives the same results as repeatedly calling inferknowledgeBaseFromRules() 
+ * as long as the knowledge base was already fully infered before changedWords were modified
+ * 
+ * @rs the set of rules
+ * @kb the knowledge base
+ * @changedWords the words changed since the last inference, updated with the words still changed when rounds run out
+ * @numRounds the maximium number of rounds to run
+ * @verbose print discoveries
+ * 
+ * @return 1 if a novel solution is found, -1 if a contradiction is found, 0 otherwise
+*/
+int inferknowledgeBaseFromRulesIncremental(RuleSet* rs, KnowledgeBase* kb, long changedWords[NUM_SETS], int numRounds, int verbose);
+
+/**
+ * inferknowledgeBaseFromNewRules() - inferknowledgeBaseFromRulesIncremental() for a knowledge base infered before
+ * some rules were added, the new rules are checked along with the rules watching the changed words
+ * 
+ * @rs the set of rules
+ * @kb the knowledge base
+ * @changedWords the words changed since the last inference, updated with the words still changed when rounds run out
+ * @firstNewRule the first rule the knowledge base hasn't been infered with
+ * @numRounds the maximium number of rounds to run
+ * @verbose print discoveries
+ * 
+ * @return 1 if a novel solution is found, -1 if a contradiction is found, 0 otherwise
+*/
+int inferknowledgeBaseFromNewRules(RuleSet* rs, KnowledgeBase* kb, long changedWords[NUM_SETS], int firstNewRule, int numRounds, int verbose);
+
+/**
+ * markFunctionChanged() - mark the word holding a function as changed
+ * 
+ * @changedWords the changed words bitstrings to update
+ * @set the setID/index of the function
+ * @function the functionID/index of the function
 */
-int inferknowledgeBaseFromRules(RuleSet* rs, KnowledgeBase* kb, int verbose);
\ No newline at end of file
+void markFunctionChanged(long changedWords[NUM_SETS], int set, int function);
\ No newline at end of file
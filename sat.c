@@ -0,0 +1,1040 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2025 Jacob Adams
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "knowledge.h"
+#include "rules.h"
+#include "util.h"
+#include "sat.h"
+
+#define CLAUSE_HEADER 2 //Size and flags before the literals of a clause
+#define CLAUSE_LEARNT 1 //Flag of learnt clauses, the rest of the flags are its LBD
+#define MAX_GROUND_INSTANCES 16384 //Instances of a rule added up front, rules with more are checked against each model instead
+#define RESTART_BASE 100 //Conflicts in the first restart, later ones follow the luby sequence
+#define ACTIVITY_DECAY 0.95
+#define MAX_KEPT_LBD 64 //Learnt clauses spanning more decision levels than this are the first to go
+
+/**
+ * growArray() - make an array bigger, exiting if there is no memory
+ * 
+ * @array the array (can be NULL)
+ * @capacity the number of items it should hold
+ * @size the size of an item
+ * 
+ * @return the bigger array
+*/
+static void* growArray(void* array, long capacity, size_t size)
+{
+    array = realloc(array, capacity*size);
+    if (array == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    return array;
+}
+
+static inline int getVar(int literal)
+{
+    return literal >> 1;
+}
+
+static inline int* getClauseLiterals(SatSolver* solver, int clause)
+{
+    return &solver->CLAUSES[clause + CLAUSE_HEADER];
+}
+
+static inline int getClauseSize(SatSolver* solver, int clause)
+{
+    return solver->CLAUSES[clause];
+}
+
+/**
+ * heapUp() - move a variable towards the top of the activity heap
+ * 
+ * @solver the solver
+ * @position where the variable is in the heap
+*/
+static void heapUp(SatSolver* solver, int position)
+{
+    int var = solver->HEAP[position];
+    while (position > 0)
+    {
+        int parent = (position-1) / 2;
+        if (solver->ACTIVITY[solver->HEAP[parent]] >= solver->ACTIVITY[var]) break;
+        solver->HEAP[position] = solver->HEAP[parent];
+        solver->HEAP_INDEX[solver->HEAP[position]] = position;
+        position = parent;
+    }
+    solver->HEAP[position] = var;
+    solver->HEAP_INDEX[var] = position;
+}
+
+/**
+ * heapDown() - move a variable towards the bottom of the activity heap
+ * 
+ * @solver the solver
+ * @position where the variable is in the heap
+*/
+static void heapDown(SatSolver* solver, int position)
+{
+    int var = solver->HEAP[position];
+    while (1)
+    {
+        int child = 2*position + 1;
+        if (child >= solver->HEAP_SIZE) break;
+        if (child+1 < solver->HEAP_SIZE && solver->ACTIVITY[solver->HEAP[child+1]] > solver->ACTIVITY[solver->HEAP[child]]) child++;
+        if (solver->ACTIVITY[solver->HEAP[child]] <= solver->ACTIVITY[var]) break;
+        solver->HEAP[position] = solver->HEAP[child];
+        solver->HEAP_INDEX[solver->HEAP[position]] = position;
+        position = child;
+    }
+    solver->HEAP[position] = var;
+    solver->HEAP_INDEX[var] = position;
+}
+
+static void heapInsert(SatSolver* solver, int var)
+{
+    if (solver->HEAP_INDEX[var] != -1) return;
+    solver->HEAP[solver->HEAP_SIZE] = var;
+    solver->HEAP_SIZE++;
+    heapUp(solver, solver->HEAP_SIZE-1);
+}
+
+static int heapPop(SatSolver* solver)
+{
+    int var = solver->HEAP[0];
+    solver->HEAP_SIZE--;
+    solver->HEAP_INDEX[var] = -1;
+    if (solver->HEAP_SIZE > 0)
+    {
+        solver->HEAP[0] = solver->HEAP[solver->HEAP_SIZE];
+        heapDown(solver, 0);
+    }
+    return var;
+}
+
+/**
+ * bumpActivity() - make a variable in a conflict more likely to be decided next
+ * 
+ * @solver the solver
+ * @var the variable
+*/
+static void bumpActivity(SatSolver* solver, int var)
+{
+    solver->ACTIVITY[var] += solver->ACTIVITY_INCREMENT;
+    if (solver->ACTIVITY[var] > 1e100)
+    { //Rescale before the activities overflow
+        for (int i = 0; i < solver->NUM_VARS; i++) solver->ACTIVITY[i] *= 1e-100;
+        solver->ACTIVITY_INCREMENT *= 1e-100;
+    }
+    if (solver->HEAP_INDEX[var] != -1) heapUp(solver, solver->HEAP_INDEX[var]);
+}
+
+/**
+ * newVar() - add a variable to a solver
+ * 
+ * @solver the solver
+ * @pair the function pair of the variable (-1 for a counting variable)
+ * 
+ * @return the variable
+*/
+static int newVar(SatSolver* solver, int pair)
+{
+    if (solver->NUM_VARS == solver->VARS_CAPACITY)
+    {
+        int capacity = solver->VARS_CAPACITY ? 2*solver->VARS_CAPACITY : 1024;
+        solver->PAIR_OF_VAR = (int*) growArray(solver->PAIR_OF_VAR, capacity, sizeof(int));
+        solver->VALUE = (signed char*) growArray(solver->VALUE, 2*capacity, sizeof(signed char));
+        solver->LEVEL = (int*) growArray(solver->LEVEL, capacity, sizeof(int));
+        solver->REASON = (int*) growArray(solver->REASON, capacity, sizeof(int));
+        solver->PHASE = (signed char*) growArray(solver->PHASE, capacity, sizeof(signed char));
+        solver->SEEN = (char*) growArray(solver->SEEN, capacity, sizeof(char));
+        solver->ACTIVITY = (double*) growArray(solver->ACTIVITY, capacity, sizeof(double));
+        solver->HEAP = (int*) growArray(solver->HEAP, capacity, sizeof(int));
+        solver->HEAP_INDEX = (int*) growArray(solver->HEAP_INDEX, capacity, sizeof(int));
+        solver->TRAIL = (int*) growArray(solver->TRAIL, capacity, sizeof(int));
+        solver->TRAIL_LIMITS = (int*) growArray(solver->TRAIL_LIMITS, capacity+1, sizeof(int));
+        solver->WATCHES = (int**) growArray(solver->WATCHES, 2*capacity, sizeof(int*));
+        solver->NUM_WATCHES = (int*) growArray(solver->NUM_WATCHES, 2*capacity, sizeof(int));
+        solver->WATCHES_CAPACITY = (int*) growArray(solver->WATCHES_CAPACITY, 2*capacity, sizeof(int));
+        solver->VARS_CAPACITY = capacity;
+    }
+    int var = solver->NUM_VARS;
+    solver->NUM_VARS++;
+
+    solver->PAIR_OF_VAR[var] = pair;
+    solver->VALUE[2*var] = 0;
+    solver->VALUE[2*var+1] = 0;
+    solver->LEVEL[var] = 0;
+    solver->REASON[var] = -1;
+    solver->PHASE[var] = -1;
+    solver->SEEN[var] = 0;
+    solver->ACTIVITY[var] = 0;
+    solver->HEAP_INDEX[var] = -1;
+    for (int literal = 2*var; literal <= 2*var+1; literal++)
+    {
+        solver->WATCHES[literal] = NULL;
+        solver->NUM_WATCHES[literal] = 0;
+        solver->WATCHES_CAPACITY[literal] = 0;
+    }
+    heapInsert(solver, var);
+    return var;
+}
+
+/**
+ * toSatLiteral() - get the solver literal of a function literal, adding its variable if needed
+ * 
+ * @solver the solver
+ * @literal the function literal
+ * 
+ * @return the solver literal
+*/
+static int toSatLiteral(SatSolver* solver, int literal)
+{
+    int pair = literal >> 1;
+    if (solver->VAR_OF_PAIR[pair] == -1) solver->VAR_OF_PAIR[pair] = newVar(solver, pair);
+    return 2*solver->VAR_OF_PAIR[pair] + (literal & 1);
+}
+
+static void addWatch(SatSolver* solver, int literal, int clause)
+{
+    if (solver->NUM_WATCHES[literal] == solver->WATCHES_CAPACITY[literal])
+    {
+        solver->WATCHES_CAPACITY[literal] = solver->WATCHES_CAPACITY[literal] ? 2*solver->WATCHES_CAPACITY[literal] : 4;
+        solver->WATCHES[literal] = (int*) growArray(solver->WATCHES[literal], solver->WATCHES_CAPACITY[literal], sizeof(int));
+    }
+    solver->WATCHES[literal][solver->NUM_WATCHES[literal]] = clause;
+    solver->NUM_WATCHES[literal]++;
+}
+
+/**
+ * storeClause() - add a clause of at least two literals to the arena and watch its first two literals
+ * 
+ * @solver the solver
+ * @literals the solver literals
+ * @numLiterals the number of literals
+ * @flags CLAUSE_LEARNT and the LBD for learnt clauses, 0 otherwise
+ * 
+ * @return where the clause starts
+*/
+static int storeClause(SatSolver* solver, int* literals, int numLiterals, int flags)
+{
+    if (solver->CLAUSES_SIZE + CLAUSE_HEADER + numLiterals > solver->CLAUSES_CAPACITY)
+    {
+        while (solver->CLAUSES_SIZE + CLAUSE_HEADER + numLiterals > solver->CLAUSES_CAPACITY) solver->CLAUSES_CAPACITY *= 2;
+        solver->CLAUSES = (int*) growArray(solver->CLAUSES, solver->CLAUSES_CAPACITY, sizeof(int));
+    }
+    if (solver->CLAUSES_SIZE + CLAUSE_HEADER + numLiterals > 0x7fffffffL)
+    { //Clauses are referred to by an int
+        printf("TOO MANY CLAUSES!\n");
+        exit(1);
+    }
+    int clause = solver->CLAUSES_SIZE;
+    solver->CLAUSES[clause] = numLiterals;
+    solver->CLAUSES[clause+1] = flags;
+    memcpy(&solver->CLAUSES[clause + CLAUSE_HEADER], literals, numLiterals*sizeof(int));
+    solver->CLAUSES_SIZE += CLAUSE_HEADER + numLiterals;
+
+    addWatch(solver, literals[0], clause);
+    addWatch(solver, literals[1], clause);
+    return clause;
+}
+
+/**
+ * assign() - make a literal TRUE
+ * 
+ * @solver the solver
+ * @literal the literal
+ * @reason the clause that implied it, -1 for a decision
+*/
+static inline void assign(SatSolver* solver, int literal, int reason)
+{
+    int var = getVar(literal);
+    solver->VALUE[literal] = 1;
+    solver->VALUE[literal^1] = -1;
+    solver->LEVEL[var] = solver->NUM_LEVELS;
+    solver->REASON[var] = reason;
+    solver->TRAIL[solver->TRAIL_SIZE] = literal;
+    solver->TRAIL_SIZE++;
+}
+
+/**
+ * propagate() - assign every literal implied by the assignments not yet propagated
+ * 
+ * @solver the solver
+ * 
+ * @return the clause that is FALSE if a conflict was found, -1 otherwise
+*/
+static int propagate(SatSolver* solver)
+{
+    while (solver->QUEUE_HEAD < solver->TRAIL_SIZE)
+    {
+        int falseLiteral = solver->TRAIL[solver->QUEUE_HEAD] ^ 1;
+        solver->QUEUE_HEAD++;
+
+        int* watches = solver->WATCHES[falseLiteral];
+        int numWatches = solver->NUM_WATCHES[falseLiteral];
+        int kept = 0;
+        for (int i = 0; i < numWatches; i++)
+        {
+            int clause = watches[i];
+            int* literals = getClauseLiterals(solver, clause);
+
+            //Keep the FALSE literal second so the first is the one that may be implied
+            if (literals[0] == falseLiteral)
+            {
+                literals[0] = literals[1];
+                literals[1] = falseLiteral;
+            }
+            if (solver->VALUE[literals[0]] == 1)
+            { //Already satisfied
+                watches[kept++] = clause;
+                continue;
+            }
+
+            //Look for another literal to watch
+            int size = getClauseSize(solver, clause);
+            int moved = 0;
+            for (int k = 2; k < size; k++)
+            {
+                if (solver->VALUE[literals[k]] != -1)
+                {
+                    literals[1] = literals[k];
+                    literals[k] = falseLiteral;
+                    addWatch(solver, literals[1], clause);
+                    moved = 1;
+                    break;
+                }
+            }
+            if (moved) continue;
+
+            watches[kept++] = clause;
+            if (solver->VALUE[literals[0]] == -1)
+            { //Every literal is FALSE
+                for (i++; i < numWatches; i++) watches[kept++] = watches[i];
+                solver->NUM_WATCHES[falseLiteral] = kept;
+                return clause;
+            }
+            assign(solver, literals[0], clause);
+        }
+        solver->NUM_WATCHES[falseLiteral] = kept;
+    }
+    return -1;
+}
+
+/**
+ * backtrack() - undo every assignment made after a decision level
+ * 
+ * @solver the solver
+ * @level the level to go back to
+*/
+static void backtrack(SatSolver* solver, int level)
+{
+    if (solver->NUM_LEVELS <= level) return;
+    for (int i = solver->TRAIL_SIZE-1; i >= solver->TRAIL_LIMITS[level]; i--)
+    {
+        int literal = solver->TRAIL[i];
+        int var = getVar(literal);
+        solver->VALUE[literal] = 0;
+        solver->VALUE[literal^1] = 0;
+        solver->PHASE[var] = (literal & 1) ? -1 : 1;
+        heapInsert(solver, var);
+    }
+    solver->TRAIL_SIZE = solver->TRAIL_LIMITS[level];
+    solver->QUEUE_HEAD = solver->TRAIL_SIZE;
+    solver->NUM_LEVELS = level;
+}
+
+/**
+ * addSolverClause() - add a clause of solver literals at decision level 0
+ * 
+ * @solver the solver
+ * @literals the literals
+ * @numLiterals the number of literals
+*/
+static void addSolverClause(SatSolver* solver, const int* literals, int numLiterals)
+{
+    backtrack(solver, 0);
+    if (solver->UNSATISFIABLE) return;
+    solver->NUM_CLAUSES++;
+
+    //Drop literals that are FALSE or repeated, the clause is already satisfied if one is TRUE or it has both values of a variable
+    int clause[numLiterals > 0 ? numLiterals : 1];
+    int size = 0;
+    for (int i = 0; i < numLiterals; i++)
+    {
+        int literal = literals[i];
+        if (solver->VALUE[literal] == 1 || solver->SEEN[getVar(literal)] == 2 - (literal & 1))
+        {
+            size = -1;
+            break;
+        }
+        if (solver->VALUE[literal] == -1 || solver->SEEN[getVar(literal)]) continue;
+        solver->SEEN[getVar(literal)] = 1 + (literal & 1);
+        clause[size++] = literal;
+    }
+    for (int i = 0; i < numLiterals; i++) solver->SEEN[getVar(literals[i])] = 0;
+    if (size == -1) return;
+
+    if (size == 0)
+    {
+        solver->UNSATISFIABLE = 1;
+        return;
+    }
+    if (size == 1)
+    {
+        assign(solver, clause[0], -1);
+        if (propagate(solver) != -1) solver->UNSATISFIABLE = 1;
+        return;
+    }
+    storeClause(solver, clause, size, 0);
+}
+
+void addSatClause(SatSolver* solver, int* literals, int numLiterals)
+{
+    int satLiterals[numLiterals > 0 ? numLiterals : 1];
+    for (int i = 0; i < numLiterals; i++) satLiterals[i] = toSatLiteral(solver, literals[i]);
+    addSolverClause(solver, satLiterals, numLiterals);
+}
+
+/**
+ * addAtMost() - add clauses so at most some of the literals are TRUE when the guards are
+ * uses a sequential counter: counter[i][j] is TRUE if more than j of the first i+1 literals are TRUE
+ * 
+ * @solver the solver
+ * @guards the solver literals guarding the constraint, FALSE guards turn it off
+ * @numGuards the number of guards
+ * @literals the solver literals to count
+ * @numLiterals the number of literals
+ * @maxCount the most literals that can be TRUE
+*/
+static void addAtMost(SatSolver* solver, int* guards, int numGuards, int* literals, int numLiterals, int maxCount)
+{
+    if (maxCount >= numLiterals) return;
+
+    int clause[numGuards + 3];
+    for (int i = 0; i < numGuards; i++) clause[i] = guards[i] ^ 1;
+    if (maxCount < 0)
+    { //Can never hold
+        addSolverClause(solver, clause, numGuards);
+        return;
+    }
+    if (maxCount == 0)
+    {
+        for (int i = 0; i < numLiterals; i++)
+        {
+            clause[numGuards] = literals[i] ^ 1;
+            addSolverClause(solver, clause, numGuards+1);
+        }
+        return;
+    }
+    if (maxCount == numLiterals-1)
+    { //Not all of them, one clause instead of a counter
+        int all[numGuards + numLiterals];
+        for (int i = 0; i < numGuards; i++) all[i] = clause[i];
+        for (int i = 0; i < numLiterals; i++) all[numGuards+i] = literals[i] ^ 1;
+        addSolverClause(solver, all, numGuards + numLiterals);
+        return;
+    }
+
+    //Only the clauses blocking a count too high need the guards, the counter can always count up
+    int counter[numLiterals][maxCount];
+    for (int i = 0; i < numLiterals-1; i++)
+    {
+        for (int j = 0; j < maxCount; j++) counter[i][j] = 2*newVar(solver, -1);
+    }
+    int pair[2];
+    for (int i = 0; i < numLiterals; i++)
+    {
+        int literal = literals[i];
+        if (i > 0)
+        { //Too many if one more is TRUE
+            clause[numGuards] = literal ^ 1;
+            clause[numGuards+1] = counter[i-1][maxCount-1] ^ 1;
+            addSolverClause(solver, clause, numGuards+2);
+        }
+        if (i == numLiterals-1) break;
+
+        pair[0] = literal ^ 1;
+        pair[1] = counter[i][0];
+        addSolverClause(solver, pair, 2);
+        for (int j = 0; j < maxCount; j++)
+        {
+            if (i > 0)
+            {
+                pair[0] = counter[i-1][j] ^ 1;
+                pair[1] = counter[i][j];
+                addSolverClause(solver, pair, 2);
+            }
+            if (j > 0 && i > 0)
+            {
+                int step[3] = {literal ^ 1, counter[i-1][j-1] ^ 1, counter[i][j]};
+                addSolverClause(solver, step, 3);
+            }
+        }
+    }
+}
+
+void addSatCount(SatSolver* solver, int* guards, int numGuards, int* literals, int numLiterals, int minCount, int maxCount)
+{
+    int satGuards[numGuards > 0 ? numGuards : 1];
+    int satLiterals[numLiterals > 0 ? numLiterals : 1];
+    for (int i = 0; i < numGuards; i++) satGuards[i] = toSatLiteral(solver, guards[i]);
+    for (int i = 0; i < numLiterals; i++) satLiterals[i] = toSatLiteral(solver, literals[i]);
+    addAtMost(solver, satGuards, numGuards, satLiterals, numLiterals, maxCount);
+
+    //At least minCount TRUE is at most numLiterals-minCount FALSE
+    for (int i = 0; i < numLiterals; i++) satLiterals[i] ^= 1;
+    addAtMost(solver, satGuards, numGuards, satLiterals, numLiterals, numLiterals - minCount);
+}
+
+/**
+ * addGroundRuleClauses() - add the clauses of one instance of a rule (passed to groundRule())
+ * 
+ * @arg the solver
+ * @ground the instance
+*/
+static void addGroundRuleClauses(void* arg, GroundRule* ground)
+{
+    SatSolver* solver = (SatSolver*) arg;
+    if (ground->isCounting)
+    {
+        int numCounted = ground->numResults/2;
+        int counted[numCounted];
+        for (int i = 0; i < numCounted; i++)
+        {
+            counted[i] = ground->results[2*i];
+            if (ground->results[2*i+1] != (counted[i]^1))
+            { //The function known when it is FALSE isn't its own negation, so tie them together
+                int tie[2] = {counted[i], ground->results[2*i+1]};
+                addSatClause(solver, tie, 2);
+                tie[0] ^= 1;
+                tie[1] ^= 1;
+                addSatClause(solver, tie, 2);
+            }
+        }
+        addSatCount(solver, ground->conditions, ground->numConditions, counted, numCounted, ground->minCount, ground->maxCount);
+        return;
+    }
+
+    //conditions => result is NOT condition OR ... OR result
+    int clause[ground->numConditions + 1];
+    for (int r = 0; r < ground->numResults; r++)
+    {
+        for (int i = 0; i < ground->numConditions; i++) clause[i] = ground->conditions[i] ^ 1;
+        clause[ground->numConditions] = ground->results[r];
+        addSatClause(solver, clause, ground->numConditions + 1);
+    }
+}
+
+/**
+ * registerWordFunctions() - add a variable for every function of a rule word on some elements
+ * 
+ * @solver the solver
+ * @set the set of the elements
+ * @from the first element
+ * @to the element after the last
+ * @word the word of the functions
+ * @mask the functions in the word
+*/
+static void registerWordFunctions(SatSolver* solver, int set, int from, int to, int word, long mask)
+{
+    for (int element = from; element < to; element++)
+    {
+        unsigned long bits = (unsigned long) mask;
+        while (bits != 0)
+        {
+            toSatLiteral(solver, FUNCTION_LITERAL(set, element, word*INT_LENGTH + __builtin_ctzl(bits)));
+            bits &= bits - 1;
+        }
+    }
+}
+
+/**
+ * registerRuleFunctions() - add a variable for every function a rule reads or writes on every element
+ * so a model decides all of them before the rule is checked against it
+ * 
+ * @solver the solver
+ * @rule the rule
+ * @kb the knowledge base the rule is for
+*/
+static void registerRuleFunctions(SatSolver* solver, Rule* rule, KnowledgeBase* kb)
+{
+    for (int var = 0; var < rule->varCount; var++)
+    {
+        int set = rule->varConditionFromSet[var];
+        for (int i = rule->varConditionStart[var]; i < rule->varConditionStart[var+1]; i++)
+        {
+            registerWordFunctions(solver, set, 0, kb->SET_SIZES[set], rule->words[i].index, rule->words[i].mask);
+        }
+    }
+    for (int i = rule->countedStart; i < rule->countedStart + 2*rule->numCounted; i++)
+    {
+        int element = rule->words[i].index / FUNCTION_RESULT_SIZE;
+        registerWordFunctions(solver, rule->countedFromSet, element, element+1, rule->words[i].index % FUNCTION_RESULT_SIZE, rule->words[i].mask);
+    }
+    if (rule->numParamValues > 0)
+    {
+        int paramEnd = rule->words[rule->paramStart + rule->numParamValues].index;
+        for (int i = rule->words[rule->paramStart].index; i < paramEnd; i++)
+        {
+            int slot = rule->words[i].index / FUNCTION_RESULT_SIZE;
+            int set = (slot < rule->varCount) ? rule->varConditionFromSet[slot] : rule->resultFromSet;
+            registerWordFunctions(solver, set, 0, kb->SET_SIZES[set], rule->words[i].index % FUNCTION_RESULT_SIZE, rule->words[i].mask);
+        }
+    }
+    for (int i = rule->resultStart; i < rule->numWords; i++)
+    {
+        registerWordFunctions(solver, rule->resultFromSet, 0, kb->SET_SIZES[rule->resultFromSet], rule->words[i].index, rule->words[i].mask);
+    }
+}
+
+/**
+ * isRedundantLiteral() - check if a literal of a learnt clause is implied by the others
+ * (every other literal of its reason is in the clause or FALSE at level 0)
+ * 
+ * @solver the solver
+ * @literal the literal
+ * 
+ * @return TRUE if it can be removed
+*/
+static int isRedundantLiteral(SatSolver* solver, int literal)
+{
+    int reason = solver->REASON[getVar(literal)];
+    if (reason == -1) return 0;
+    int* literals = getClauseLiterals(solver, reason);
+    for (int i = 1; i < getClauseSize(solver, reason); i++)
+    {
+        int var = getVar(literals[i]);
+        if (!solver->SEEN[var] && solver->LEVEL[var] > 0) return 0;
+    }
+    return 1;
+}
+
+/**
+ * analyseConflict() - learn a clause from a conflict (the first unique implication point)
+ * 
+ * @solver the solver
+ * @conflict the clause that is FALSE
+ * @learnt OUTPUTS the learnt clause, the first literal is implied once the solver backtracks
+ * @backtrackLevel OUTPUTS the level to backtrack to
+ * @lbd OUTPUTS how many decision levels the clause spans
+ * 
+ * @return the size of the learnt clause
+*/
+static int analyseConflict(SatSolver* solver, int conflict, int* learnt, int* backtrackLevel, int* lbd)
+{
+    int size = 1; //learnt[0] is filled in last
+    int pathCount = 0;
+    int literal = -1;
+    int position = solver->TRAIL_SIZE-1;
+    do
+    {
+        int* literals = getClauseLiterals(solver, conflict);
+        for (int i = (literal == -1) ? 0 : 1; i < getClauseSize(solver, conflict); i++)
+        {
+            int var = getVar(literals[i]);
+            if (solver->SEEN[var] || solver->LEVEL[var] == 0) continue;
+            solver->SEEN[var] = 1;
+            bumpActivity(solver, var);
+            if (solver->LEVEL[var] == solver->NUM_LEVELS) pathCount++;
+            else learnt[size++] = literals[i];
+        }
+
+        //Next literal of this level in the conflict
+        while (!solver->SEEN[getVar(solver->TRAIL[position])]) position--;
+        literal = solver->TRAIL[position];
+        position--;
+        conflict = solver->REASON[getVar(literal)];
+        solver->SEEN[getVar(literal)] = 0;
+        pathCount--;
+    } while (pathCount > 0);
+    learnt[0] = literal ^ 1;
+
+    //Drop literals implied by the rest, every literal stays SEEN until all are checked
+    int seen[size];
+    memcpy(seen, learnt, size*sizeof(int));
+    int kept = 1;
+    for (int i = 1; i < size; i++)
+    {
+        if (!isRedundantLiteral(solver, learnt[i])) learnt[kept++] = learnt[i];
+    }
+    for (int i = 1; i < size; i++) solver->SEEN[getVar(seen[i])] = 0;
+    size = kept;
+
+    //The literal of the highest level goes second so it is watched
+    *backtrackLevel = 0;
+    for (int i = 1; i < size; i++)
+    {
+        if (solver->LEVEL[getVar(learnt[i])] > *backtrackLevel)
+        {
+            *backtrackLevel = solver->LEVEL[getVar(learnt[i])];
+            int swap = learnt[1];
+            learnt[1] = learnt[i];
+            learnt[i] = swap;
+        }
+    }
+
+    char levelSeen[solver->NUM_LEVELS+1];
+    memset(levelSeen, 0, solver->NUM_LEVELS+1);
+    *lbd = 0;
+    for (int i = 0; i < size; i++)
+    {
+        int level = solver->LEVEL[getVar(learnt[i])];
+        if (!levelSeen[level]) *lbd += 1;
+        levelSeen[level] = 1;
+    }
+    return size;
+}
+
+/**
+ * rebuildWatches() - watch the first two literals of every clause again
+ * 
+ * @solver the solver
+*/
+static void rebuildWatches(SatSolver* solver)
+{
+    for (int literal = 0; literal < 2*solver->NUM_VARS; literal++) solver->NUM_WATCHES[literal] = 0;
+    for (long clause = 0; clause < solver->CLAUSES_SIZE; clause += CLAUSE_HEADER + solver->CLAUSES[clause])
+    {
+        int* literals = getClauseLiterals(solver, clause);
+        addWatch(solver, literals[0], clause);
+        addWatch(solver, literals[1], clause);
+    }
+}
+
+/**
+ * reduceLearnts() - forget about half of the learnt clauses, the ones that span the most decision levels
+ * only called at level 0, where no learnt clause is the reason for an assignment that conflict analysis looks at
+ * 
+ * @solver the solver
+*/
+static void reduceLearnts(SatSolver* solver)
+{
+    //Find the LBD that splits the learnt clauses in half
+    int numWithLBD[MAX_KEPT_LBD+1] = {0};
+    for (int i = 0; i < solver->NUM_LEARNTS; i++)
+    {
+        int lbd = solver->CLAUSES[solver->LEARNTS[i]+1] >> 1;
+        numWithLBD[lbd < MAX_KEPT_LBD ? lbd : MAX_KEPT_LBD]++;
+    }
+    int keepLBD = 2; //Clauses spanning few levels are always kept
+    for (int kept = numWithLBD[0] + numWithLBD[1] + numWithLBD[2]; keepLBD < MAX_KEPT_LBD && kept + numWithLBD[keepLBD+1] <= solver->NUM_LEARNTS/2; keepLBD++)
+    {
+        kept += numWithLBD[keepLBD+1];
+    }
+    for (int i = 0; i < solver->NUM_LEARNTS; i++)
+    {
+        int clause = solver->LEARNTS[i];
+        if ((solver->CLAUSES[clause+1] >> 1) > keepLBD) solver->CLAUSES[clause+1] = -1; //Mark removed
+    }
+
+    //Compact the arena, clauses stay in the same order
+    long size = 0;
+    solver->NUM_LEARNTS = 0;
+    for (long clause = 0; clause < solver->CLAUSES_SIZE; )
+    {
+        int length = CLAUSE_HEADER + solver->CLAUSES[clause];
+        if (solver->CLAUSES[clause+1] != -1)
+        {
+            memmove(&solver->CLAUSES[size], &solver->CLAUSES[clause], length*sizeof(int));
+            if (solver->CLAUSES[size+1] & CLAUSE_LEARNT) solver->LEARNTS[solver->NUM_LEARNTS++] = size;
+            size += length;
+        }
+        clause += length;
+    }
+    solver->CLAUSES_SIZE = size;
+
+    //Level 0 assignments are never analysed so their reasons can go
+    for (int i = 0; i < solver->TRAIL_SIZE; i++) solver->REASON[getVar(solver->TRAIL[i])] = -1;
+    rebuildWatches(solver);
+    solver->MAX_LEARNTS += solver->MAX_LEARNTS/10;
+}
+
+/**
+ * search() - look for a model until a conflict budget runs out
+ * 
+ * @solver the solver
+ * @maxConflicts the conflict budget
+ * 
+ * @return 1 if a model was found, 0 if there is none, -1 if the budget ran out
+*/
+static int search(SatSolver* solver, long maxConflicts)
+{
+    long numConflicts = 0;
+    int* learnt = (int*) growArray(NULL, solver->NUM_VARS+1, sizeof(int));
+    int result = -1;
+    while (1)
+    {
+        int conflict = propagate(solver);
+        if (conflict != -1)
+        {
+            solver->NUM_CONFLICTS++;
+            numConflicts++;
+            if (solver->NUM_LEVELS == 0)
+            {
+                solver->UNSATISFIABLE = 1;
+                result = 0;
+                break;
+            }
+
+            int backtrackLevel, lbd;
+            int size = analyseConflict(solver, conflict, learnt, &backtrackLevel, &lbd);
+            backtrack(solver, backtrackLevel);
+            if (size == 1)
+            {
+                assign(solver, learnt[0], -1);
+            }
+            else
+            {
+                int clause = storeClause(solver, learnt, size, CLAUSE_LEARNT | (lbd << 1));
+                if (solver->NUM_LEARNTS == solver->LEARNTS_CAPACITY)
+                {
+                    solver->LEARNTS_CAPACITY *= 2;
+                    solver->LEARNTS = (int*) growArray(solver->LEARNTS, solver->LEARNTS_CAPACITY, sizeof(int));
+                }
+                solver->LEARNTS[solver->NUM_LEARNTS++] = clause;
+                assign(solver, learnt[0], clause);
+            }
+            solver->ACTIVITY_INCREMENT /= ACTIVITY_DECAY;
+            continue;
+        }
+
+        if (numConflicts >= maxConflicts) break;
+
+        //Decide the most active unassigned variable
+        int var = -1;
+        while (solver->HEAP_SIZE > 0 && var == -1)
+        {
+            var = heapPop(solver);
+            if (solver->VALUE[2*var] != 0) var = -1;
+        }
+        if (var == -1)
+        { //Every variable is assigned
+            result = 1;
+            break;
+        }
+        solver->TRAIL_LIMITS[solver->NUM_LEVELS] = solver->TRAIL_SIZE;
+        solver->NUM_LEVELS++;
+        assign(solver, 2*var + (solver->PHASE[var] == 1 ? 0 : 1), -1);
+    }
+    free(learnt);
+    return result;
+}
+
+/**
+ * getLuby() - get an item of the luby sequence (1, 1, 2, 1, 1, 2, 4, 1, ...)
+ * 
+ * @i the item
+ * 
+ * @return the item
+*/
+static long getLuby(long i)
+{
+    long size = 1;
+    int power = 0;
+    while (size < i+1)
+    {
+        power++;
+        size = 2*size + 1;
+    }
+    while (size-1 != i)
+    {
+        size = (size-1) / 2;
+        power--;
+        i = i % size;
+    }
+    return 1L << power;
+}
+
+/**
+ * addBrokenLazyClauses() - add the clauses of lazy rule instances the current model breaks
+ * 
+ * @solver the solver, holding a model
+ * 
+ * @return TRUE if any clause was added
+*/
+static int addBrokenLazyClauses(SatSolver* solver)
+{
+    if (solver->NUM_LAZY_RULES == 0) return 0;
+
+    resetKnowledgeBase(solver->MODEL);
+    writeSatModel(solver, solver->MODEL);
+
+    //Every function the rules read is decided, so only instances that hold and are broken are listed
+    long numClauses = solver->NUM_CLAUSES;
+    for (int i = 0; i < solver->NUM_LAZY_RULES; i++)
+    {
+        groundRule(getRule(solver->RULES, solver->LAZY_RULES[i]), solver->MODEL, MAX_GROUND_LITERALS*(long)MAX_GROUND_INSTANCES, &addGroundRuleClauses, solver);
+    }
+    return solver->NUM_CLAUSES != numClauses;
+}
+
+int solveSat(SatSolver* solver, RandState* rng, long maxConflicts)
+{
+    backtrack(solver, 0);
+    if (solver->UNSATISFIABLE) return 0;
+
+    if (rng != NULL)
+    { //Start from a random order and random values, conflicts soon take over the order
+        for (int var = 0; var < solver->NUM_VARS; var++)
+        {
+            solver->ACTIVITY[var] = solver->ACTIVITY_INCREMENT * (getRandLong(rng) >> 11) * (1.0 / (1L << 53));
+            solver->PHASE[var] = (getRandLong(rng) & 1) ? 1 : -1;
+        }
+        for (int i = solver->HEAP_SIZE/2 - 1; i >= 0; i--) heapDown(solver, i);
+    }
+
+    long startConflicts = solver->NUM_CONFLICTS;
+    for (long restart = 0; ; restart++)
+    {
+        long budget = RESTART_BASE * getLuby(restart);
+        if (maxConflicts >= 0)
+        {
+            long left = maxConflicts - (solver->NUM_CONFLICTS - startConflicts);
+            if (left <= 0) return -1;
+            if (budget > left) budget = left;
+        }
+
+        int result = search(solver, budget);
+        if (result == 0) return 0;
+        if (result == 1)
+        {
+            if (!addBrokenLazyClauses(solver)) return 1;
+            if (solver->UNSATISFIABLE) return 0;
+        }
+
+        backtrack(solver, 0);
+        if (solver->NUM_LEARNTS > solver->MAX_LEARNTS) reduceLearnts(solver);
+    }
+}
+
+void writeSatModel(SatSolver* solver, KnowledgeBase* kb)
+{
+    for (int var = 0; var < solver->NUM_VARS; var++)
+    {
+        int pair = solver->PAIR_OF_VAR[var];
+        if (pair == -1 || solver->VALUE[2*var] == 0) continue;
+
+        int literal = 2*pair + (solver->VALUE[2*var] == 1 ? 0 : 1);
+        addKnowledge(kb, LITERAL_SET(literal), LITERAL_ELEMENT(literal), LITERAL_FUNCTION(literal));
+    }
+}
+
+SatSolver* initSatSolver(RuleSet* rs, KnowledgeBase* kb)
+{
+    SatSolver* solver = (SatSolver*) malloc(sizeof(SatSolver));
+    if (solver == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    memset(solver, 0, sizeof(SatSolver));
+
+    solver->VAR_OF_PAIR = (int*) growArray(NULL, NUM_FUNCTION_LITERALS/2, sizeof(int));
+    for (int pair = 0; pair < NUM_FUNCTION_LITERALS/2; pair++) solver->VAR_OF_PAIR[pair] = -1;
+    solver->VARS_CAPACITY = 0;
+    solver->ACTIVITY_INCREMENT = 1.0;
+    solver->CLAUSES_CAPACITY = 1024;
+    solver->CLAUSES = (int*) growArray(NULL, solver->CLAUSES_CAPACITY, sizeof(int));
+    solver->LEARNTS_CAPACITY = 1024;
+    solver->LEARNTS = (int*) growArray(NULL, solver->LEARNTS_CAPACITY, sizeof(int));
+    solver->TRAIL_LIMITS = (int*) growArray(NULL, 1, sizeof(int));
+    solver->RULES = rs;
+    solver->LAZY_RULES = (int*) growArray(NULL, rs->NUM_RULES > 0 ? rs->NUM_RULES : 1, sizeof(int));
+    solver->MODEL = initKBFromTemplate(kb);
+
+    //What is known is a unit clause
+    for (int set = 0; set < NUM_SETS; set++)
+    {
+        for (int element = 0; element < kb->SET_SIZES[set]; element++)
+        {
+            for (int word = 0; word < FUNCTION_RESULT_SIZE; word++)
+            {
+                unsigned long bits = (unsigned long) kb->KNOWLEDGE_BASE[set][element][word];
+                while (bits != 0)
+                {
+                    int literal = FUNCTION_LITERAL(set, element, word*INT_LENGTH + __builtin_ctzl(bits));
+                    bits &= bits - 1;
+                    addSatClause(solver, &literal, 1);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < rs->NUM_RULES; i++)
+    {
+        if (rs->RULE_ACTIVE[i] == 0) continue; //Nothing left for it to find
+        Rule* rule = getRule(rs, i);
+        if (rule->numCounted > 0)
+        {
+            groundRule(rule, kb, MAX_GROUND_LITERALS*(long)MAX_GROUND_INSTANCES, &addGroundRuleClauses, solver);
+        }
+        else if (groundRule(rule, kb, MAX_GROUND_INSTANCES, &addGroundRuleClauses, solver) == -1)
+        {
+            registerRuleFunctions(solver, rule, kb);
+            solver->LAZY_RULES[solver->NUM_LAZY_RULES++] = i;
+        }
+    }
+    solver->MAX_LEARNTS = solver->NUM_CLAUSES/3 + 4096;
+    return solver;
+}
+
+void freeSatSolver(SatSolver* solver)
+{
+    for (int literal = 0; literal < 2*solver->NUM_VARS; literal++) free(solver->WATCHES[literal]);
+    free(solver->WATCHES);
+    free(solver->NUM_WATCHES);
+    free(solver->WATCHES_CAPACITY);
+    free(solver->VAR_OF_PAIR);
+    free(solver->PAIR_OF_VAR);
+    free(solver->VALUE);
+    free(solver->LEVEL);
+    free(solver->REASON);
+    free(solver->PHASE);
+    free(solver->SEEN);
+    free(solver->ACTIVITY);
+    free(solver->HEAP);
+    free(solver->HEAP_INDEX);
+    free(solver->TRAIL);
+    free(solver->TRAIL_LIMITS);
+    free(solver->CLAUSES);
+    free(solver->LEARNTS);
+    free(solver->LAZY_RULES);
+    free(solver->MODEL);
+    free(solver);
+}
+
+int isConsistentSat(RuleSet* rs, KnowledgeBase* kb)
+{
+    SatSolver* solver = initSatSolver(rs, kb);
+    int result = solveSat(solver, NULL, -1);
+    freeSatSolver(solver);
+    return result == 1;
+}
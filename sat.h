@@ -0,0 +1,163 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2025 Jacob Adams
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "knowledge.h"
+#include "rules.h"
+#include "util.h"
+
+/*
+ * A conflict driven clause learning SAT solver over the functions of a knowledge base
+ * each function pair (function and its negation) that appears in a clause is one variable,
+ * extra variables are only used to encode counting rules
+ *
+ * Internally literal 2*var is the variable being TRUE (the even function of the pair) and 2*var+1 it being FALSE
+ * so like function literals (see FUNCTION_LITERAL()) a literal^1 is its negation
+*/
+typedef struct {
+    //Variables
+    int NUM_VARS;
+    int VARS_CAPACITY;
+    int* VAR_OF_PAIR; //Variable of each function pair (function literal / 2), -1 if it isn't in any clause
+    int* PAIR_OF_VAR; //Function pair of each variable, -1 for counting variables
+    signed char* VALUE; //Of each literal, 1 TRUE, -1 FALSE, 0 unassigned
+    int* LEVEL; //Decision level each variable was assigned at
+    int* REASON; //Clause that implied each variable, -1 for decisions
+    signed char* PHASE; //Last value of each variable, reused when it is next decided
+    char* SEEN; //Scratch marks for conflict analysis
+    double* ACTIVITY; //How often each variable was in a recent conflict
+    double ACTIVITY_INCREMENT;
+
+    //Unassigned variables by activity (a binary max heap)
+    int* HEAP;
+    int* HEAP_INDEX; //Where each variable is in HEAP, -1 if not in it
+    int HEAP_SIZE;
+
+    //Assignments in order, TRAIL_LIMITS[level] is where each decision level starts
+    int* TRAIL;
+    int TRAIL_SIZE;
+    int* TRAIL_LIMITS;
+    int NUM_LEVELS;
+    int QUEUE_HEAD; //Assignments before this have been propagated
+
+    //Clauses are stored back to back as [size, flags, literals...]
+    int* CLAUSES;
+    long CLAUSES_SIZE;
+    long CLAUSES_CAPACITY;
+    int* LEARNTS; //Where each learnt clause starts
+    int NUM_LEARNTS;
+    int LEARNTS_CAPACITY;
+    int MAX_LEARNTS; //Learnt clauses kept before half are removed
+
+    //Clauses watching each literal, the lists are visited when the literal becomes FALSE
+    int** WATCHES;
+    int* NUM_WATCHES;
+    int* WATCHES_CAPACITY;
+
+    //Rules with too many instances to add up front, their clauses are added when a model breaks them
+    RuleSet* RULES;
+    int* LAZY_RULES;
+    int NUM_LAZY_RULES;
+    KnowledgeBase* MODEL; //Scratch knowledge base the lazy rules are checked in
+
+    int UNSATISFIABLE; //TRUE once the clauses are known to have no model
+    long NUM_CONFLICTS;
+    long NUM_CLAUSES; //Clauses added (not learnt)
+} SatSolver;
+
+/**
+ * initSatSolver() - compile the rules and the facts of a knowledge base into clauses
+ * every instance of every active rule is a clause (or a counter for counting rules)
+ * and every known function is a unit clause
+ * 
+ * @rs the rules, must not change while the solver is used
+ * @kb the knowledge base
+ * 
+ * @return the solver
+*/
+SatSolver* initSatSolver(RuleSet* rs, KnowledgeBase* kb);
+
+/**
+ * freeSatSolver() - free a solver
+ * 
+ * @solver the solver
+*/
+void freeSatSolver(SatSolver* solver);
+
+/**
+ * addSatClause() - add a clause to a solver, at least one of the literals must be TRUE
+ * 
+ * @solver the solver
+ * @literals the function literals of the clause (see FUNCTION_LITERAL())
+ * @numLiterals the number of literals
+*/
+void addSatClause(SatSolver* solver, int* literals, int numLiterals);
+
+/**
+ * addSatCount() - add a counting constraint to a solver
+ * when every guard is TRUE between minCount and maxCount of the literals must be TRUE
+ * 
+ * @solver the solver
+ * @guards the function literals guarding the constraint
+ * @numGuards the number of guards (0 for a constraint that always holds)
+ * @literals the function literals to count
+ * @numLiterals the number of literals
+ * @minCount the fewest literals that can be TRUE
+ * @maxCount the most literals that can be TRUE
+*/
+void addSatCount(SatSolver* solver, int* guards, int numGuards, int* literals, int numLiterals, int minCount, int maxCount);
+
+/**
+ * solveSat() - search for a model of the clauses
+ * the search keeps what it learnt, so later calls (e.g. for more worlds) are faster
+ * 
+ * @solver the solver
+ * @rng randomises the order and values variables are tried in so each call can find a different model (NULL to not randomise)
+ * @maxConflicts conflicts before the search gives up (-1 for no limit)
+ * 
+ * @return 1 if a model was found, 0 if there is none, -1 if the search gave up
+*/
+int solveSat(SatSolver* solver, RandState* rng, long maxConflicts);
+
+/**
+ * writeSatModel() - add the model found by the last successful solveSat() to a knowledge base
+ * every function pair in a clause is set one way or the other
+ * 
+ * @solver the solver
+ * @kb the knowledge base to add the model to
+*/
+void writeSatModel(SatSolver* solver, KnowledgeBase* kb);
+
+/**
+ * isConsistentSat() - check if a knowledge base has some complete world that breaks none of the rules
+ * unlike inferImplicitFacts() this finds every contradiction, however many steps it takes to reach
+ * 
+ * @rs the rules
+ * @kb the knowledge base
+ * 
+ * @return TRUE if some world is consistent
+*/
+int isConsistentSat(RuleSet* rs, KnowledgeBase* kb);
@@ -292,193 +292,187 @@ static void roleAssociation(RuleSet* rs, KnowledgeBase* kb, const int NUM_PLAYER
      * IDEA: Roles have associated data with them
      * For the most part!! a Player IS Demon => player IS Evil etc. etc.
     */
-    for (int night = 0; night < NUM_DAYS; night++)
+    for (int role = 0; role < NUM_BOTCT_ROLES; role++)
     {
-        for (int role = 0; role < NUM_BOTCT_ROLES; role++)
+        if (ROLE_IN_SCRIPT[role])
         {
-            if (ROLE_IN_SCRIPT[role])
-            {
-                //A role implies a team (assuming the role was made the normal way)
-                //<PLAYER>is_<ROLE> AND <PLAYER>is_NOT_ROLE_CHANGED => <PLAYER>is_<ROLE_TEAM>
-                setTempRuleParams(rs, 2,0);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_TEAMS[role], night);
-                setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_ROLE_CHANGED_[NIGHT%d]", night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BOUNTY_HUNTER_in_PLAY_[NIGHT%d]", night);
-                addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                pushTempRule(rs);
+            //A role implies a team (assuming the role was made the normal way)
+            //<PLAYER>is_<ROLE> AND <PLAYER>is_NOT_ROLE_CHANGED => <PLAYER>is_<ROLE_TEAM>
+            setTempRuleParams(rs, 2,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_TEAMS[role]);
+            setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_ROLE_CHANGED_[NIGHT%d]", 0);
+            addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BOUNTY_HUNTER_in_PLAY_[NIGHT%d]", 0);
+            pushTempRule(rs);
 
-                //A role implies a class
-                //Unlike alingment the class is always implied by a role
-                //<PLAYER>is_<ROLE> => <PLAYER>is_<ROLE_CLASS>
-                setTempRuleParams(rs, 1,0);
-                
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_CLASSES[role], night);
-                setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                pushTempRule(rs);
-            }
+            //A role implies a class
+            //Unlike alingment the class is always implied by a role
+            //<PLAYER>is_<ROLE> => <PLAYER>is_<ROLE_CLASS>
+            setTempRuleParams(rs, 1,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_CLASSES[role]);
+            setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+            pushTempRule(rs);
         }
+    }
 
-        //If a player is none of the roles within a class that player can't be that class (deduction)
-        //<PLAYER>is_NOT_IMP => <PLAYER>is_NOT_DEMON
-        setTempRuleParams(rs, 1,0);
-        
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_DEMON_[NIGHT%d]", night);
-        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    //If a player is none of the roles within a class that player can't be that class (deduction)
+    //<PLAYER>is_NOT_IMP => <PLAYER>is_NOT_DEMON
+    setTempRuleParams(rs, 1,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_NOT_DEMON_[NIGHT%d]", 0);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_CLASSES[i], "DEMON") == 0)
         {
-            if (strcmp(ROLE_CLASSES[i], "DEMON") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        pushTempRule(rs);
+    }
+    pushTempRule(rs);
 
-        //The converse is also true
-        setTempRuleParams(rs, 1,0);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    //The converse is also true
+    setTempRuleParams(rs, 1,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_CLASSES[i], "DEMON") == 0)
         {
-            if (strcmp(ROLE_CLASSES[i], "DEMON") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_DEMON_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-        pushTempRule(rs);
+    }
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_DEMON_[NIGHT%d]", 0);
+    pushTempRule(rs);
 
-        //<PLAYER>is_NOT_BARON AND <PLAYER>is_NOT_SCARLET_WOMAN AND <PLAYER>is_NOT_SPY AND <PLAYER>is_NOT_POISONER=> <PLAYER>is_NOT_MINION
-        setTempRuleParams(rs, 1,0);
-        
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MINION_[NIGHT%d]", night);
-        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    //<PLAYER>is_NOT_BARON AND <PLAYER>is_NOT_SCARLET_WOMAN AND <PLAYER>is_NOT_SPY AND <PLAYER>is_NOT_POISONER=> <PLAYER>is_NOT_MINION
+    setTempRuleParams(rs, 1,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_NOT_MINION_[NIGHT%d]", 0);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_CLASSES[i], "MINION") == 0)
         {
-            if (strcmp(ROLE_CLASSES[i], "MINION") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        pushTempRule(rs);
+    }
+    pushTempRule(rs);
 
-        //The converse is also true
-        setTempRuleParams(rs, 1,0);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    //The converse is also true
+    setTempRuleParams(rs, 1,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_CLASSES[i], "MINION") == 0)
         {
-            if (strcmp(ROLE_CLASSES[i], "MINION") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MINION_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-        pushTempRule(rs);
+    }
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_MINION_[NIGHT%d]", 0);
+    pushTempRule(rs);
 
-        //<PLAYER>is_NOT_BUTLER AND <PLAYER>is_NOT_DRUNK AND <PLAYER>is_NOT_RECLUSE AND <PLAYER>is_NOT_SAINT=> <PLAYER>is_NOT_OUTSIDER
-        setTempRuleParams(rs, 1,0);
-        
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_OUTSIDER_[NIGHT%d]", night);
-        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    //<PLAYER>is_NOT_BUTLER AND <PLAYER>is_NOT_DRUNK AND <PLAYER>is_NOT_RECLUSE AND <PLAYER>is_NOT_SAINT=> <PLAYER>is_NOT_OUTSIDER
+    setTempRuleParams(rs, 1,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_NOT_OUTSIDER_[NIGHT%d]", 0);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_CLASSES[i], "OUTSIDER") == 0)
         {
-            if (strcmp(ROLE_CLASSES[i], "OUTSIDER") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        pushTempRule(rs);
+    }
+    pushTempRule(rs);
 
-        //The converse is also true
-        setTempRuleParams(rs, 1,0);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    //The converse is also true
+    setTempRuleParams(rs, 1,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_CLASSES[i], "OUTSIDER") == 0)
         {
-            if (strcmp(ROLE_CLASSES[i], "OUTSIDER") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_OUTSIDER_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-        pushTempRule(rs);
+    }
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_OUTSIDER_[NIGHT%d]", 0);
+    pushTempRule(rs);
 
 
-        //<PLAYER>is_NOT_WASHERWOMAN AND <PLAYER>is_NOT_LIBRARIAN AND <PLAYER>is_NOT_INVESTIGATOR AND <PLAYER>is_NOT_CHEF
-        //AND <PLAYER>is_NOT_EMPATH AND <PLAYER>is_NOT_FORTUNE_TELLER AND <PLAYER>is_NOT_UNDERTAKER AND <PLAYER>is_NOT_MONK
-        //AND <PLAYER>is_NOT_RAVENKEEPER AND <PLAYER>is_NOT_VIRGIN AND <PLAYER>is_NOT_SLAYER AND <PLAYER>is_NOT_SOLDIER
-        //AND <PLAYER>is_NOT_MAYOR => <PLAYER>is_NOT_TOWNSFOLK
-        setTempRuleParams(rs, 1,0);
-        
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_TOWNSFOLK_[NIGHT%d]", night);
-        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    //<PLAYER>is_NOT_WASHERWOMAN AND <PLAYER>is_NOT_LIBRARIAN AND <PLAYER>is_NOT_INVESTIGATOR AND <PLAYER>is_NOT_CHEF
+    //AND <PLAYER>is_NOT_EMPATH AND <PLAYER>is_NOT_FORTUNE_TELLER AND <PLAYER>is_NOT_UNDERTAKER AND <PLAYER>is_NOT_MONK
+    //AND <PLAYER>is_NOT_RAVENKEEPER AND <PLAYER>is_NOT_VIRGIN AND <PLAYER>is_NOT_SLAYER AND <PLAYER>is_NOT_SOLDIER
+    //AND <PLAYER>is_NOT_MAYOR => <PLAYER>is_NOT_TOWNSFOLK
+    setTempRuleParams(rs, 1,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_NOT_TOWNSFOLK_[NIGHT%d]", 0);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_CLASSES[i], "TOWNSFOLK") == 0)
         {
-            if (strcmp(ROLE_CLASSES[i], "TOWNSFOLK") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        pushTempRule(rs);
+    }
+    pushTempRule(rs);
 
-        //The converse is also true
-        setTempRuleParams(rs, 1,0);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    //The converse is also true
+    setTempRuleParams(rs, 1,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_CLASSES[i], "TOWNSFOLK") == 0)
         {
-            if (strcmp(ROLE_CLASSES[i], "TOWNSFOLK") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_TOWNSFOLK_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-        pushTempRule(rs);
+    }
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_TOWNSFOLK_[NIGHT%d]", 0);
+    pushTempRule(rs);
 
-        //If the role hasn't been change you are definitely the correct alignment for your role
-        //Assuming a bounty hunter isn't in play
-        setTempRuleParams(rs, 2,0);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    //If the role hasn't been change you are definitely the correct alignment for your role
+    //Assuming a bounty hunter isn't in play
+    setTempRuleParams(rs, 2,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_TEAMS[i], "GOOD") == 0)
         {
-            if (strcmp(ROLE_TEAMS[i], "GOOD") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        snprintf(buff, STRING_BUFF_SIZE, "is_EVIL_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_ROLE_CHANGED_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BOUNTY_HUNTER_in_PLAY_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-        pushTempRule(rs);
+    }
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_EVIL_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_ROLE_CHANGED_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BOUNTY_HUNTER_in_PLAY_[NIGHT%d]", 0);
+    pushTempRule(rs);
 
-        setTempRuleParams(rs, 1,0);
-        for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    setTempRuleParams(rs, 1,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    for (int i = 0; i < NUM_BOTCT_ROLES; i++)
+    {
+        if (strcmp(ROLE_TEAMS[i], "EVIL") == 0)
         {
-            if (strcmp(ROLE_TEAMS[i], "EVIL") == 0)
-            {
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[i], night);
-                setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[i]);
+            setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0);
         }
-        snprintf(buff, STRING_BUFF_SIZE, "is_GOOD_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_ROLE_CHANGED_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-        pushTempRule(rs);
     }
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_GOOD_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_ROLE_CHANGED_[NIGHT%d]", 0);
+    pushTempRule(rs);
 }
 
 /**
@@ -504,58 +498,56 @@ static void roleMutuallyExclusive(RuleSet* rs, KnowledgeBase* kb, const int NUM_
      * IDEA: Every player has exactly one role and only one player can have that role
      * For the most part (excluding dead players)
     */
-    for (int night = 0; night < NUM_DAYS; night++)
+    for (int role = 0; role < NUM_BOTCT_ROLES; role++)
     {
-        for (int role = 0; role < NUM_BOTCT_ROLES; role++)
+        if (ROLE_IN_SCRIPT[role])
         {
-            if (ROLE_IN_SCRIPT[role])
-            {
-                //<PLAYER_A>is_<ROLE> AND <PLAYER_A>is_ALIVE AND <PLAYER_B>is_ALIVE => <PLAYER_B>is_NOT<ROLE>
-                // IDEA: Only one alive player can have a role
-                if (strcmp(ROLE_NAMES[role], "VILLAGE_IDIOT") != 0)
-                { //Village idiots are not mutually exclusive
-                    setTempRuleParams(rs, 2,1);
-                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                    setTempRuleResultName(rs, kb, 1, "PLAYERS", buff);
-                    snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                    addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                    snprintf(buff, STRING_BUFF_SIZE, "is_ALIVE_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                    snprintf(buff, STRING_BUFF_SIZE, "is_ALIVE_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 1, "PLAYERS", buff);
-                    pushTempRule(rs);
-                }
+            //<PLAYER_A>is_<ROLE> AND <PLAYER_A>is_ALIVE AND <PLAYER_B>is_ALIVE => <PLAYER_B>is_NOT<ROLE>
+            // IDEA: Only one alive player can have a role
+            if (strcmp(ROLE_NAMES[role], "VILLAGE_IDIOT") != 0)
+            { //Village idiots are not mutually exclusive
+                setTempRuleParams(rs, 2,1);
+                setTempRuleTemplate(rs, NUM_DAYS, -1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                setParamTempRuleResultName(rs, kb, 1, "PLAYERS", buff, 0);
+                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_ALIVE_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "PLAYERS", "is_ALIVE_[NIGHT%d]", 0);
+                pushTempRule(rs);
+            }
 
-                //<PLAYER>is_NOT_{<ROLE_A>, <ROLE_B>...} => <PLAYER>is_<ROLE_Z>
-                // IDEA: A player MUST have one role so by deduction if only one role is remaining they are that role
-                setTempRuleParams(rs, 1,0);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                setTempRuleResultName(rs, kb, 0, "PLAYERS", buff); //A player is role ROLE_NAME[i] if
-                for (int j = 0; j < NUM_BOTCT_ROLES; j++)
-                {
-                    if (role!=j)
-                    { //A player is NOT role ROLE_NAME[j] for all i!=j
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[j], night);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                    }
+            //<PLAYER>is_NOT_{<ROLE_A>, <ROLE_B>...} => <PLAYER>is_<ROLE_Z>
+            // IDEA: A player MUST have one role so by deduction if only one role is remaining they are that role
+            setTempRuleParams(rs, 1,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+            setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0); //A player is role ROLE_NAME[i] if
+            for (int j = 0; j < NUM_BOTCT_ROLES; j++)
+            {
+                if (role!=j)
+                { //A player is NOT role ROLE_NAME[j] for all i!=j
+                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[j]);
+                    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
                 }
-                pushTempRule(rs);
+            }
+            pushTempRule(rs);
 
-                //<PLAYER>is_<ROLE_A> => <PLAYER>is_NOT<ROLE_B>
-                // IDEA: Each player only has one role
-                setTempRuleParams(rs, 1,0);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                for (int j = 0; j < NUM_BOTCT_ROLES; j++)
-                {
-                    if (role!=j)
-                    { //I and j are mutually exclusive
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[j], night);
-                        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                    }
+            //<PLAYER>is_<ROLE_A> => <PLAYER>is_NOT<ROLE_B>
+            // IDEA: Each player only has one role
+            setTempRuleParams(rs, 1,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+            for (int j = 0; j < NUM_BOTCT_ROLES; j++)
+            {
+                if (role!=j)
+                { //I and j are mutually exclusive
+                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[j]);
+                    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 0);
                 }
-                pushTempRule(rs);
             }
+            pushTempRule(rs);
         }
     }
 }
@@ -600,84 +592,79 @@ static void roleMetaData(RuleSet* rs, KnowledgeBase* kb, const int NUM_PLAYERS,
                     addConditionToTempRuleName(rs,kb, j, "PLAYERS", buff);
                 }
                 pushTempRule(rs);
+            }
+        }
+    }
 
-                
-                //<PLAYER>is_<ROLE> => <METADATA>is_<ROLE>_in_PLAY
-                // IDEA: If a player is a role that role is in play (obviously)
-                setTempRuleParams(rs, 1,0);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[role], night);
-                setTempRuleResultName(rs, kb, -1, "METADATA", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                pushTempRule(rs);
+    //The rest are templates over the night
+    for (int role = 0; role < NUM_BOTCT_ROLES; role++)
+    {
+        if (ROLE_IN_SCRIPT[role])
+        {
+            //<PLAYER>is_<ROLE> => <METADATA>is_<ROLE>_in_PLAY
+            // IDEA: If a player is a role that role is in play (obviously)
+            setTempRuleParams(rs, 1,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%%d]", ROLE_NAMES[role]);
+            setParamTempRuleResultName(rs, kb, -1, "METADATA", buff, 0);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+            pushTempRule(rs);
 
-                //<PLAYER>is_<ROLE> AND <PLAYER>is_ALIVE => <METADATA>is_<ROLE>_ALIVE
-                // IDEA: If a player is a role and is alive that role is in play and alive (obviously)
-                setTempRuleParams(rs, 1,0);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_ALIVE_[NIGHT%d]", ROLE_NAMES[role], night);
-                setTempRuleResultName(rs, kb, -1, "METADATA", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_ALIVE_[NIGHT%d]", night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                pushTempRule(rs);
+            //<PLAYER>is_<ROLE> AND <PLAYER>is_ALIVE => <METADATA>is_<ROLE>_ALIVE
+            // IDEA: If a player is a role and is alive that role is in play and alive (obviously)
+            setTempRuleParams(rs, 1,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_ALIVE_[NIGHT%%d]", ROLE_NAMES[role]);
+            setParamTempRuleResultName(rs, kb, -1, "METADATA", buff, 0);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_ALIVE_[NIGHT%d]", 0);
+            pushTempRule(rs);
 
-                //<PLAYER>is_<ROLE> => <METADATA>is_<ROLE>_in_PLAY
-                // IDEA: If a player is a role and is alive that role is in play and alive (obviously)
-                setTempRuleParams(rs, 1,0);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[role], night);
-                setTempRuleResultName(rs, kb, -1, "METADATA", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                pushTempRule(rs);
+            //<PLAYER>is_<ROLE> => <METADATA>is_<ROLE>_in_PLAY
+            // IDEA: If a player is a role and is alive that role is in play and alive (obviously)
+            setTempRuleParams(rs, 1,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%%d]", ROLE_NAMES[role]);
+            setParamTempRuleResultName(rs, kb, -1, "METADATA", buff, 0);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+            addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+            pushTempRule(rs);
 
-                //<METADATA>is_NOT_<ROLE>_in_PLAY => <PLAYER>is_NOT_<ROLE>
-                // IDEA: [take the contrapositive] If a role is not in play... no one is that role
-                setTempRuleParams(rs, 1,0);
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], night);
-                setTempRuleResultName(rs, kb, -1, "PLAYERS", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[role], night);
-                addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                pushTempRule(rs);
+            //<METADATA>is_NOT_<ROLE>_in_PLAY => <PLAYER>is_NOT_<ROLE>
+            // IDEA: [take the contrapositive] If a role is not in play... no one is that role
+            setTempRuleParams(rs, 1,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+            setParamTempRuleResultName(rs, kb, -1, "PLAYERS", buff, 0);
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%%d]", ROLE_NAMES[role]);
+            addParamConditionToTempRuleName(rs, kb, 0, "METADATA", buff, 0);
+            pushTempRule(rs);
 
-                //<METADATA>is_NOT_<ROLE>_in_PLAY => <METADATA>is_NOT_<ROLE>_ALIVE
-                // If A role is NOT in play no one can be that alive role
-                setTempRuleParams(rs, 1,0);
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_ALIVE_[NIGHT%d]", ROLE_NAMES[role], night);
-                setTempRuleResultName(rs, kb, 0, "METADATA", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[role], night);
-                addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                pushTempRule(rs);
+            //<METADATA>is_NOT_<ROLE>_in_PLAY => <METADATA>is_NOT_<ROLE>_ALIVE
+            // If A role is NOT in play no one can be that alive role
+            setTempRuleParams(rs, 1,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_ALIVE_[NIGHT%%d]", ROLE_NAMES[role]);
+            setParamTempRuleResultName(rs, kb, 0, "METADATA", buff, 0);
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%%d]", ROLE_NAMES[role]);
+            addParamConditionToTempRuleName(rs, kb, 0, "METADATA", buff, 0);
+            pushTempRule(rs);
 
-                //<METADATA>is_<ROLE>_ALIVE => <METADATA>is_<ROLE>_in_PLAY
-                // Contrapositive of rule above
-                setTempRuleParams(rs, 1,0);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[role], night);
-                setTempRuleResultName(rs, kb, 0, "METADATA", buff);
-                snprintf(buff, STRING_BUFF_SIZE, "is_%s_ALIVE_[NIGHT%d]", ROLE_NAMES[role], night);
-                addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                pushTempRule(rs);
-            }
+            //<METADATA>is_<ROLE>_ALIVE => <METADATA>is_<ROLE>_in_PLAY
+            // Contrapositive of rule above
+            setTempRuleParams(rs, 1,0);
+            setTempRuleTemplate(rs, NUM_DAYS, -1);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%%d]", ROLE_NAMES[role]);
+            setParamTempRuleResultName(rs, kb, 0, "METADATA", buff, 0);
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_ALIVE_[NIGHT%%d]", ROLE_NAMES[role]);
+            addParamConditionToTempRuleName(rs, kb, 0, "METADATA", buff, 0);
+            pushTempRule(rs);
         }
     }
 }
 
-static int ipow(int base, int exp)
-{
-    int result = 1;
-    for (;;)
-    {
-        if (exp & 1)
-            result *= base;
-        exp >>= 1;
-        if (!exp)
-            break;
-        base *= base;
-    }
-
-    return result;
-}
-
 /*
 NOTE: I think this function my need to be updated
 */
@@ -696,6 +683,7 @@ static void roleMetaDataCounting(RuleSet* rs, KnowledgeBase* kb, const int NUM_P
 {
     //Temporary string buffer for writing names into
     char buff[STRING_BUFF_SIZE];
+    char notBuff[STRING_BUFF_SIZE];
     // ===========================================
     //  Role Metadata Counting Arguments
     // ===========================================
@@ -708,70 +696,23 @@ static void roleMetaDataCounting(RuleSet* rs, KnowledgeBase* kb, const int NUM_P
      * These rules ONLY works on night 0 as roles can change which changes the distrubution of roles
     */
     int night = 0; //Set night to 0
-    //If found all minions in play set all unused minions to is_NOT_<MINION>_in_PLAY
-    int numUnusedMinions = TOTAL_MINIONS-NUM_MINIONS;
-
-    int NUM_MINION_PERMS = ipow(2, TOTAL_MINIONS);
+    
+    //Exactly NUM_MINIONS minions are in play
+    //once they are all found the rest are is_NOT_<MINION>_in_PLAY, once the rest are ruled out they are all is_<MINION>_in_PLAY
     if (0 < NUM_MINIONS && NUM_MINIONS < TOTAL_MINIONS)
     {
-        for (int i = 0; i < NUM_MINION_PERMS; i++)
+        setTempRuleParams(rs, 0,0);
+        setTempRuleCount(rs, NUM_MINIONS, NUM_MINIONS);
+        for (int j = 0; j < TOTAL_MINIONS; j++)
         {
-            //Permute all subsets
-            int count = 0;
-            for (int j = 0; j < TOTAL_MINIONS; j++)
-            {
-                if (((i >> j) & 1) == 1)
-                {
-                    count++;
-                }
-            }
-            if (count == NUM_MINIONS)
-            {
-                //<METADATA>is_NOT_<MINION>_in_PLAY => <METADATA>is_<MINION>_in_PLAY
-                setTempRuleParams(rs, 1,0);
-                
-
-                for (int j = 0; j < TOTAL_MINIONS; j++)
-                {
-                    if (((i >> j) & 1) == 1)
-                    {
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[MINION_INDICIES[j]], night);
-                        addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                    }
-                    else
-                    {
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[MINION_INDICIES[j]], night);
-                        setTempRuleResultName(rs, kb, 0, "METADATA", buff);
-                    }
-                }
-                pushTempRule(rs);
-            }
-            if (count == numUnusedMinions)
-            {
-                //<PLAYER>is_<MINION>_in_PLAY => <METADATA>is_NOT_<MINION>_in_PLAY
-                setTempRuleParams(rs, 1,0);
-                
-
-                for (int j = 0; j < TOTAL_MINIONS; j++)
-                {
-                    if (((i >> j) & 1) == 1)
-                    {
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[MINION_INDICIES[j]], night);
-                        addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                    }
-                    else
-                    {
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[MINION_INDICIES[j]], night);
-                        setTempRuleResultName(rs, kb, 0, "METADATA", buff);
-                    }
-                }
-                pushTempRule(rs);
-            }
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[MINION_INDICIES[j]], night);
+            snprintf(notBuff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[MINION_INDICIES[j]], night);
+            addCountedToTempRuleName(rs, kb, "METADATA", 0, buff, notBuff);
         }
+        pushTempRule(rs);
     }
     
-    int NUM_OUTSIDER_PERMS = ipow(2, TOTAL_OUTSIDERS);
-    int NUM_MOD_PERMS = ipow(2, 3);
+    int NUM_MOD_PERMS = 1 << 3;
     for (int k = 0; k < NUM_MOD_PERMS; k++)
     {
         int isBaronInPlay = k&1;
@@ -792,161 +733,69 @@ static void roleMetaDataCounting(RuleSet* rs, KnowledgeBase* kb, const int NUM_P
         {
             numOutsiders -= 1;
         }
-        int numUnusedOutsiders = TOTAL_OUTSIDERS-numOutsiders;
+        if (numOutsiders < 0 || numOutsiders > TOTAL_OUTSIDERS) continue;
 
-        for (int i = 0; i < NUM_OUTSIDER_PERMS; i++)
+        //<METADATA>is_NOT_BARON_in_PLAY AND ... => exactly numOutsiders of <METADATA>is_<OUTSIDER>_in_PLAY
+        setTempRuleParams(rs, 1,0);
+        setTempRuleCount(rs, numOutsiders, numOutsiders);
+        
+        //Check for outsider count modifiers
+        if (isBaronInPlay == 1)
         {
-            //Permute all subsets
-            int count = 0;
-            for (int j = 0; j < TOTAL_OUTSIDERS; j++)
-            {
-                if (((i >> j) & 1) == 1)
-                {
-                    count++;
-                }
-            }
-            if (count == numOutsiders)
-            {
-                //<METADATA>is_<OUTSIDER>_in_PLAY (xA) AND <METADATA>is_NOT_BARON_in_PLAY => <METADATA>is_NOT_<OUTSIDER>_in_PLAY (x4-A)
-                setTempRuleParams(rs, 1,0);
-                
-                //Check for outsider count modifiers
-                if (isBaronInPlay == 1)
-                {
-                    //The BARON must be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_BARON_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                else
-                {
-                    //The BARON can NOT be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARON_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                if (isFangGuInPlay == 1)
-                {
-                    //The FANG_GU must be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_FANG_GU_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                else
-                {
-                    //The FANG_GU can NOT be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_FANG_GU_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                if (isVigormortisInPlay == 1)
-                {
-                    //The VIGORMORTIS must be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_VIGORMORTIS_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                else
-                {
-                    //The VIGORMORTIS can NOT be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_VIGORMORTIS_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                if (isGodFatherInPlay == 1)
-                {
-                    //The GODFATHER must be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_GODFATHER_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                else
-                {
-                    //The GODFATHER can NOT be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GODFATHER_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-
-                for (int j = 0; j < TOTAL_OUTSIDERS; j++)
-                {
-                    if (((i >> j) & 1) == 1)
-                    {
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[OUTSIDER_INDICIES[j]], night);
-                        addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                    }
-                    else
-                    {
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[OUTSIDER_INDICIES[j]], night);
-                        setTempRuleResultName(rs, kb, 0, "METADATA", buff);
-                    }
-                }
-                pushTempRule(rs);
-            }
-            if (count == numUnusedOutsiders)
-            {
-                //<METADATA>is_NOT_<OUTSIDER>_in_PLAY (xA) AND <METADATA>is_NOT_BARON_in_PLAY => <METADATA>is_<OUTSIDER>_in_PLAY (x4-A)
-                setTempRuleParams(rs, 1,0);
-                
-                //Check for outsider count modifiers
-                if (isBaronInPlay == 1)
-                {
-                    //The BARON must be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_BARON_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                else
-                {
-                    //The BARON can NOT be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARON_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                if (isFangGuInPlay == 1)
-                {
-                    //The FANG_GU must be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_FANG_GU_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                else
-                {
-                    //The FANG_GU can NOT be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_FANG_GU_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                if (isVigormortisInPlay == 1)
-                {
-                    //The VIGORMORTIS must be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_VIGORMORTIS_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                else
-                {
-                    //The VIGORMORTIS can NOT be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_VIGORMORTIS_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                if (isGodFatherInPlay == 1)
-                {
-                    //The GODFATHER must be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_GODFATHER_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-                else
-                {
-                    //The GODFATHER can NOT be in play for this
-                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GODFATHER_in_PLAY_[NIGHT%d]", night);
-                    addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                }
-
-                for (int j = 0; j < TOTAL_OUTSIDERS; j++)
-                {
-                    if (((i >> j) & 1) == 1)
-                    {
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[OUTSIDER_INDICIES[j]], night);
-                        addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
-                    }
-                    else
-                    {
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[OUTSIDER_INDICIES[j]], night);
-                        setTempRuleResultName(rs, kb, 0, "METADATA", buff);
-                    }
-                }
-                pushTempRule(rs);
-            }
+            //The BARON must be in play for this
+            snprintf(buff, STRING_BUFF_SIZE, "is_BARON_in_PLAY_[NIGHT%d]", night);
+            addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
+        }
+        else
+        {
+            //The BARON can NOT be in play for this
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARON_in_PLAY_[NIGHT%d]", night);
+            addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
+        }
+        if (isFangGuInPlay == 1)
+        {
+            //The FANG_GU must be in play for this
+            snprintf(buff, STRING_BUFF_SIZE, "is_FANG_GU_in_PLAY_[NIGHT%d]", night);
+            addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
+        }
+        else
+        {
+            //The FANG_GU can NOT be in play for this
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_FANG_GU_in_PLAY_[NIGHT%d]", night);
+            addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
+        }
+        if (isVigormortisInPlay == 1)
+        {
+            //The VIGORMORTIS must be in play for this
+            snprintf(buff, STRING_BUFF_SIZE, "is_VIGORMORTIS_in_PLAY_[NIGHT%d]", night);
+            addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
+        }
+        else
+        {
+            //The VIGORMORTIS can NOT be in play for this
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_VIGORMORTIS_in_PLAY_[NIGHT%d]", night);
+            addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
+        }
+        if (isGodFatherInPlay == 1)
+        {
+            //The GODFATHER must be in play for this
+            snprintf(buff, STRING_BUFF_SIZE, "is_GODFATHER_in_PLAY_[NIGHT%d]", night);
+            addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
+        }
+        else
+        {
+            //The GODFATHER can NOT be in play for this
+            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GODFATHER_in_PLAY_[NIGHT%d]", night);
+            addConditionToTempRuleName(rs,kb, 0, "METADATA", buff);
         }
 
+        for (int j = 0; j < TOTAL_OUTSIDERS; j++)
+        {
+            snprintf(buff, STRING_BUFF_SIZE, "is_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[OUTSIDER_INDICIES[j]], night);
+            snprintf(notBuff, STRING_BUFF_SIZE, "is_NOT_%s_in_PLAY_[NIGHT%d]", ROLE_NAMES[OUTSIDER_INDICIES[j]], night);
+            addCountedToTempRuleName(rs, kb, "METADATA", 0, buff, notBuff);
+        }
+        pushTempRule(rs);
     }
     
 }
@@ -985,54 +834,42 @@ static void teamAndClassCountingArguments(RuleSet* rs, KnowledgeBase* kb, const
     */
     int night = 0;
 
-    //RULE DISABLED DUE TO BAD PERFORMANCE
-    //EDIT: new optimisation reduces this from O(n!) down to O(n) ish ish runing so re enabled
-
-    //If all good players have been found the rest are evil
-    //<PLAYER_1>is_GOOD AND ... <PLAYER_[num good players]>is_GOOD => <PLAYER_A>is_EVIL
-    setTempRuleParams(rs, numGood,1);
-    snprintf(buff, STRING_BUFF_SIZE, "is_EVIL_[NIGHT%d]", night);
-    setTempRuleResultName(rs, kb, -1, "PLAYERS", buff); 
-    for (int j = 0; j < numGood; j++)
-    {
-        snprintf(buff, STRING_BUFF_SIZE, "is_GOOD_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, j, "PLAYERS", buff);
-    }
-    pushTempRule(rs);
+    //Counted directly so this no longer needs the O(n!) permutations of the old symmetric rules
+    char notBuff[STRING_BUFF_SIZE];
 
-    //If all evil players have been found the rest are good
-    //<PLAYER_1>is_EVIL AND ... <PLAYER_[num evil players]>is_EVIL => <PLAYER_A>is_GOOD
-    setTempRuleParams(rs, numEvil,1);
+    //There are exactly numGood good players
+    //once they are all found the rest are evil, once all evil players are found the rest are good
+    setTempRuleParams(rs, 0,0);
+    setTempRuleCount(rs, numGood, numGood);
     snprintf(buff, STRING_BUFF_SIZE, "is_GOOD_[NIGHT%d]", night);
-    setTempRuleResultName(rs, kb, -1, "PLAYERS", buff); 
-    for (int j = 0; j < numEvil; j++)
+    snprintf(notBuff, STRING_BUFF_SIZE, "is_EVIL_[NIGHT%d]", night);
+    for (int player = 0; player < NUM_PLAYERS; player++)
     {
-        snprintf(buff, STRING_BUFF_SIZE, "is_EVIL_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, j, "PLAYERS", buff);
+        addCountedToTempRuleName(rs, kb, "PLAYERS", player, buff, notBuff);
     }
     pushTempRule(rs);
 
     //If all minion players have been found the rest are not minions
-    //<PLAYER_1>is_MINION AND ... <PLAYER_[num minion players]>is_MINION => <PLAYER_A>is_NOT_MINION
-    setTempRuleParams(rs, NUM_MINIONS,1);
-    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MINION_[NIGHT%d]", night);
-    setTempRuleResultName(rs, kb, -1, "PLAYERS", buff); 
-    for (int j = 0; j < NUM_MINIONS; j++)
+    //At most NUM_MINIONS of <PLAYER>is_MINION
+    setTempRuleParams(rs, 0,0);
+    setTempRuleCount(rs, 0, NUM_MINIONS);
+    snprintf(buff, STRING_BUFF_SIZE, "is_MINION_[NIGHT%d]", night);
+    snprintf(notBuff, STRING_BUFF_SIZE, "is_NOT_MINION_[NIGHT%d]", night);
+    for (int player = 0; player < NUM_PLAYERS; player++)
     {
-        snprintf(buff, STRING_BUFF_SIZE, "is_MINION_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, j, "PLAYERS", buff);
+        addCountedToTempRuleName(rs, kb, "PLAYERS", player, buff, notBuff);
     }
     pushTempRule(rs);
 
     //If all demon players have been found the rest are not demons
-    //<PLAYER_1>is_DEMON AND ... <PLAYER_[num minion players]>is_DEMON => <PLAYER_A>is_NOT_DEMON
-    setTempRuleParams(rs, NUM_DEMONS,1);
-    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_DEMON_[NIGHT%d]", night);
-    setTempRuleResultName(rs, kb, -1, "PLAYERS", buff); 
-    for (int j = 0; j < NUM_DEMONS; j++)
+    //At most NUM_DEMONS of <PLAYER>is_DEMON
+    setTempRuleParams(rs, 0,0);
+    setTempRuleCount(rs, 0, NUM_DEMONS);
+    snprintf(buff, STRING_BUFF_SIZE, "is_DEMON_[NIGHT%d]", night);
+    snprintf(notBuff, STRING_BUFF_SIZE, "is_NOT_DEMON_[NIGHT%d]", night);
+    for (int player = 0; player < NUM_PLAYERS; player++)
     {
-        snprintf(buff, STRING_BUFF_SIZE, "is_DEMON_[NIGHT%d]", night);
-        addConditionToTempRuleName(rs,kb, j, "PLAYERS", buff);
+        addCountedToTempRuleName(rs, kb, "PLAYERS", player, buff, notBuff);
     }
     pushTempRule(rs);
     
@@ -1245,272 +1082,222 @@ static void roleContinuityArguments(RuleSet* rs, KnowledgeBase* kb, const int NU
      * IDEA: For most games peoples roles don't change throughout the game
      * 
     */
-    for (int startNight = 0; startNight < NUM_DAYS; startNight++)
+    //Templates over the night, the last night has no next night so no rules
+    for (int role = 0; role < NUM_BOTCT_ROLES; role++)
     {
-        int nextNight = startNight+1;
-        if (nextNight < NUM_DAYS)
+        if (ROLE_IN_SCRIPT[role])
         {
-            for (int role = 0; role < NUM_BOTCT_ROLES; role++)
-            {
-                if (ROLE_IN_SCRIPT[role])
+            if (strcmp(ROLE_NAMES[role], "IMP") == 0)
+            { 
+                //Imps can star pass, any minion can become the imp, 
+                //imps will remain imps unless affected snake charmers barbers or pithags
+
+                //<PLAYER>is_<ROLE> => <PLAYER>is_<ROLE>[Night x]
+                setTempRuleParams(rs, 2,0);
+                setTempRuleTemplate(rs, NUM_DAYS, -1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+                pushTempRule(rs);
+                
+                //<PLAYER>is_NOT_<ROLE> => <PLAYER>is_NOT_<ROLE>[Night x]
+                setTempRuleParams(rs, 2,0);
+                setTempRuleTemplate(rs, NUM_DAYS, -1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_MINION_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SUMMONER_in_PLAY_[NIGHT%d]", 0);
+                pushTempRule(rs);
+                
+                //<PLAYER>is_IMP AND <PLAYER>_NOT_KILLED_<PLAYER> AND <PLAYER2>=> <PLAYER2>is_NOT_IMP[Night x]
+                //A template over the imp player for each night
+                for (int startNight = 0; startNight+1 < NUM_DAYS; startNight++)
                 {
-                    if (strcmp(ROLE_NAMES[role], "IMP") == 0)
-                    { 
-                        //Imps can star pass, any minion can become the imp, 
-                        //imps will remain imps unless affected snake charmers barbers or pithags
-
-                        //<PLAYER>is_<ROLE> => <PLAYER>is_<ROLE>[Night x]
-                        setTempRuleParams(rs, 2,0);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], nextNight);
-                        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], startNight);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        pushTempRule(rs);
-                        
-                        //<PLAYER>is_NOT_<ROLE> => <PLAYER>is_NOT_<ROLE>[Night x]
-                        setTempRuleParams(rs, 2,0);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], nextNight);
-                        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], startNight);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MINION_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SUMMONER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        pushTempRule(rs);
-                        
-                        //<PLAYER>is_IMP AND <PLAYER>_NOT_KILLED_<PLAYER> AND <PLAYER2>=> <PLAYER2>is_NOT_IMP[Night x]
-                        for (int playerID = 0; playerID < NUM_PLAYERS; playerID++)
-                        {
-                            setTempRuleParams(rs, 3,1);
-                            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], nextNight);
-                            setTempRuleResultName(rs, kb, 2, "PLAYERS", buff);
-                            snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], startNight);
-                            addFixedConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff, playerID);
-                            snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%d_[NIGHT%d]", playerID, startNight);
-                            addFixedConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff, playerID);
-                            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SCARLET_WOMAN_[NIGHT%d]", startNight);
-                            addConditionToTempRuleName(rs,kb, 2, "PLAYERS", buff);
-                            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-                            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-                            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-                            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SUMMONER_in_PLAY_[NIGHT%d]", startNight);
-                            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                            pushTempRule(rs);
-                        }
-                        
-                        
-                    }
-                    else if (strcmp(ROLE_NAMES[role], "SNAKE_CHARMER") == 0)
-                    { //Snake charmers swap roles with demons
-
-                    }
-                    else if (strcmp(ROLE_CLASSES[role], "MINION") == 0)
-                    { 
-                        //Scarlet womans can become the demon, 
-                        //Minions can become the imp
-
-                        //No one will become a minion unless pithags, snake charmers or barbers are involved
-
-
-                        //<PLAYER>is_NOT_<ROLE> => <PLAYER>is_NOT_<ROLE>[Night x]
-                        setTempRuleParams(rs, 2,0);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], nextNight);
-                        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], startNight);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        pushTempRule(rs);
-                        
-                    }
-                    else if (strcmp(ROLE_CLASSES[role], "DEMON") == 0)
-                    { //Non imp demons
-                        //Scarlet womans can become the demon, 
-                        //Minions can become the imp (not needed to consider here as imps considered seperately)
-
-                        //Demons remain demons unless affected by snake charmers, barbers or pithags
-
-                        //<PLAYER>is_<ROLE> => <PLAYER>is_<ROLE>[Night x]
-                        setTempRuleParams(rs, 2,0);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], nextNight);
-                        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], startNight);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        pushTempRule(rs);
-                        
-                        //<PLAYER>is_NOT_<ROLE> => <PLAYER>is_NOT_<ROLE>[Night x]
-                        setTempRuleParams(rs, 2,0);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], nextNight);
-                        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], startNight);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SCARLET_WOMAN_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SUMMONER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        pushTempRule(rs);
-                        
-                    }
-                    else
-                    { //Everyone else is affected by barbers and pit hags
-                        //<PLAYER>is_<ROLE> => <PLAYER>is_<ROLE>[Night x]
-                        setTempRuleParams(rs, 2,0);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], nextNight);
-                        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], startNight);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        pushTempRule(rs);
-                        
-                        //<PLAYER>is_NOT_<ROLE> => <PLAYER>is_NOT_<ROLE>[Night x]
-                        setTempRuleParams(rs, 2,0);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], nextNight);
-                        setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], startNight);
-                        addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-                        addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-                        pushTempRule(rs);
-                        
-                    }
+                    setTempRuleParams(rs, 3,1);
+                    setTempRuleTemplate(rs, NUM_PLAYERS, 0);
+                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%d]", ROLE_NAMES[role], startNight+1);
+                    setTempRuleResultName(rs, kb, 2, "PLAYERS", buff);
+                    snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], startNight);
+                    addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
+                    snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%%d_[NIGHT%d]", startNight);
+                    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SCARLET_WOMAN_[NIGHT%d]", startNight);
+                    addConditionToTempRuleName(rs,kb, 2, "PLAYERS", buff);
+                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
+                    addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
+                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
+                    addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
+                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
+                    addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
+                    snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SUMMONER_in_PLAY_[NIGHT%d]", startNight);
+                    addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
+                    pushTempRule(rs);
                 }
+                
+                
             }
-            //<PLAYER>is_GOOD => <PLAYER>is_GOOD[Night x]
-            setTempRuleParams(rs, 2,0);
-            snprintf(buff, STRING_BUFF_SIZE, "is_GOOD_[NIGHT%d]", nextNight);
-            setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_GOOD_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GOON_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            pushTempRule(rs);
+            else if (strcmp(ROLE_NAMES[role], "SNAKE_CHARMER") == 0)
+            { //Snake charmers swap roles with demons
 
-            //<PLAYER>is_EVIL_ => <PLAYER>is_EVIL_[Night x]
-            setTempRuleParams(rs, 2,0);
-            snprintf(buff, STRING_BUFF_SIZE, "is_EVIL_[NIGHT%d]", nextNight);
-            setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_EVIL_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GOON_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            pushTempRule(rs);
+            }
+            else if (strcmp(ROLE_CLASSES[role], "MINION") == 0)
+            { 
+                //Scarlet womans can become the demon, 
+                //Minions can become the imp
 
-            //<PLAYER>is_TOWNSFOLK_ => <PLAYER>is_TOWNSFOLK_[Night x]
-            setTempRuleParams(rs, 2,0);
-            snprintf(buff, STRING_BUFF_SIZE, "is_TOWNSFOLK_[NIGHT%d]", nextNight);
-            setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_TOWNSFOLK_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            pushTempRule(rs);
+                //No one will become a minion unless pithags, snake charmers or barbers are involved
 
-            //<PLAYER>is_OUTSIDER_ => <PLAYER>is_OUTSIDER_[Night x]
-            setTempRuleParams(rs, 2,0);
-            snprintf(buff, STRING_BUFF_SIZE, "is_OUTSIDER_[NIGHT%d]", nextNight);
-            setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_OUTSIDER_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            pushTempRule(rs);
 
-            //<PLAYER>is_DEMON_ => <PLAYER>is_DEMON_[Night x]
-            setTempRuleParams(rs, 2,0);
-            snprintf(buff, STRING_BUFF_SIZE, "is_DEMON_[NIGHT%d]", nextNight);
-            setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_DEMON_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            pushTempRule(rs);
+                //<PLAYER>is_NOT_<ROLE> => <PLAYER>is_NOT_<ROLE>[Night x]
+                setTempRuleParams(rs, 2,0);
+                setTempRuleTemplate(rs, NUM_DAYS, -1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+                pushTempRule(rs);
+                
+            }
+            else if (strcmp(ROLE_CLASSES[role], "DEMON") == 0)
+            { //Non imp demons
+                //Scarlet womans can become the demon, 
+                //Minions can become the imp (not needed to consider here as imps considered seperately)
 
-            //<PLAYER>is_MINION_ => <PLAYER>is_MINION_[Night x]
-            //NOTE this is not true if the demon star passes
-            
-            setTempRuleParams(rs, 2,0);
-            snprintf(buff, STRING_BUFF_SIZE, "is_MINION_[NIGHT%d]", nextNight);
-            setTempRuleResultName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_MINION_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SCARLET_WOMAN_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_IMP_in_PLAY_[NIGHT%d]", startNight);
-            addConditionToTempRuleName(rs,kb, 1, "METADATA", buff);
-            
-            pushTempRule(rs);
-            
+                //Demons remain demons unless affected by snake charmers, barbers or pithags
+
+                //<PLAYER>is_<ROLE> => <PLAYER>is_<ROLE>[Night x]
+                setTempRuleParams(rs, 2,0);
+                setTempRuleTemplate(rs, NUM_DAYS, -1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+                pushTempRule(rs);
+                
+                //<PLAYER>is_NOT_<ROLE> => <PLAYER>is_NOT_<ROLE>[Night x]
+                setTempRuleParams(rs, 2,0);
+                setTempRuleTemplate(rs, NUM_DAYS, -1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_SCARLET_WOMAN_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SUMMONER_in_PLAY_[NIGHT%d]", 0);
+                pushTempRule(rs);
+                
+            }
+            else
+            { //Everyone else is affected by barbers and pit hags
+                //<PLAYER>is_<ROLE> => <PLAYER>is_<ROLE>[Night x]
+                setTempRuleParams(rs, 2,0);
+                setTempRuleTemplate(rs, NUM_DAYS, -1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+                pushTempRule(rs);
+                
+                //<PLAYER>is_NOT_<ROLE> => <PLAYER>is_NOT_<ROLE>[Night x]
+                setTempRuleParams(rs, 2,0);
+                setTempRuleTemplate(rs, NUM_DAYS, -1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                setParamTempRuleResultName(rs, kb, 0, "PLAYERS", buff, 1);
+                snprintf(buff, STRING_BUFF_SIZE, "is_NOT_%s_[NIGHT%%d]", ROLE_NAMES[role]);
+                addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+                addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+                pushTempRule(rs);
+                
+            }
         }
     }
+    //<PLAYER>is_GOOD => <PLAYER>is_GOOD[Night x]
+    setTempRuleParams(rs, 2,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_GOOD_[NIGHT%d]", 1);
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_GOOD_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_GOON_in_PLAY_[NIGHT%d]", 0);
+    pushTempRule(rs);
+
+    //<PLAYER>is_EVIL_ => <PLAYER>is_EVIL_[Night x]
+    setTempRuleParams(rs, 2,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_EVIL_[NIGHT%d]", 1);
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_EVIL_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_GOON_in_PLAY_[NIGHT%d]", 0);
+    pushTempRule(rs);
+
+    //<PLAYER>is_TOWNSFOLK_ => <PLAYER>is_TOWNSFOLK_[Night x]
+    setTempRuleParams(rs, 2,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_TOWNSFOLK_[NIGHT%d]", 1);
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_TOWNSFOLK_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+    pushTempRule(rs);
+
+    //<PLAYER>is_OUTSIDER_ => <PLAYER>is_OUTSIDER_[Night x]
+    setTempRuleParams(rs, 2,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_OUTSIDER_[NIGHT%d]", 1);
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_OUTSIDER_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+    pushTempRule(rs);
+
+    //<PLAYER>is_DEMON_ => <PLAYER>is_DEMON_[Night x]
+    setTempRuleParams(rs, 2,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_DEMON_[NIGHT%d]", 1);
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_DEMON_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+    pushTempRule(rs);
+
+    //<PLAYER>is_MINION_ => <PLAYER>is_MINION_[Night x]
+    //NOTE this is not true if the demon star passes
+    
+    setTempRuleParams(rs, 2,0);
+    setTempRuleTemplate(rs, NUM_DAYS, -1);
+    setParamTempRuleResultName(rs, kb, 0, "PLAYERS", "is_MINION_[NIGHT%d]", 1);
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_MINION_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", "is_NOT_SCARLET_WOMAN_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_SNAKE_CHARMER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_BARBER_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_PIT_HAG_in_PLAY_[NIGHT%d]", 0);
+    addParamConditionToTempRuleName(rs, kb, 1, "METADATA", "is_NOT_IMP_in_PLAY_[NIGHT%d]", 0);
+    
+    pushTempRule(rs);
 }
 
 /**
@@ -2311,297 +2098,259 @@ static void killingRules(RuleSet* rs, KnowledgeBase* kb, const int NUM_PLAYERS,
         pushTempRule(rs);
 
         //Rules to enforce maximum killings per role
-        for (int killedPlayerID = 0; killedPlayerID < NUM_PLAYERS; killedPlayerID++)
-        {
-            /*
-            IMP
-            */
-            // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
-            setTempRuleParams(rs, 1,0);
-            for (int notKilledPlayerID = 0; notKilledPlayerID < NUM_PLAYERS; notKilledPlayerID++)
-            {
-                if (notKilledPlayerID != killedPlayerID)
-                {
-                    snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%d_[NIGHT%d]", notKilledPlayerID, night);
-                    setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-                }
-            }
-            snprintf(buff, STRING_BUFF_SIZE, "KILLED_%d_[NIGHT%d]", killedPlayerID, night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_IMP_[NIGHT%d]", night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            pushTempRule(rs);
-            /*
-            ASSASSIN
-            NOTE: this actually can only be triggered once per game
-            */
-            // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
-            setTempRuleParams(rs, 1,0);
-            for (int notKilledPlayerID = 0; notKilledPlayerID < NUM_PLAYERS; notKilledPlayerID++)
-            {
-                if (notKilledPlayerID != killedPlayerID)
-                {
-                    snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%d_[NIGHT%d]", notKilledPlayerID, night);
-                    setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-                }
-            }
-            snprintf(buff, STRING_BUFF_SIZE, "KILLED_%d_[NIGHT%d]", killedPlayerID, night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_ASSASSIN_[NIGHT%d]", night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            pushTempRule(rs);
-            /*
-            FANG_GU
-            */
-            // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
-            setTempRuleParams(rs, 1,0);
-            for (int notKilledPlayerID = 0; notKilledPlayerID < NUM_PLAYERS; notKilledPlayerID++)
-            {
-                if (notKilledPlayerID != killedPlayerID)
-                {
-                    snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%d_[NIGHT%d]", notKilledPlayerID, night);
-                    setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-                }
-            }
-            snprintf(buff, STRING_BUFF_SIZE, "KILLED_%d_[NIGHT%d]", killedPlayerID, night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_FANG_GU_[NIGHT%d]", night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            pushTempRule(rs);
-            /*
-            VIGORMORTIS
-            */
-            // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
-            setTempRuleParams(rs, 1,0);
-            for (int notKilledPlayerID = 0; notKilledPlayerID < NUM_PLAYERS; notKilledPlayerID++)
-            {
-                if (notKilledPlayerID != killedPlayerID)
-                {
-                    snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%d_[NIGHT%d]", notKilledPlayerID, night);
-                    setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-                }
-            }
-            snprintf(buff, STRING_BUFF_SIZE, "KILLED_%d_[NIGHT%d]", killedPlayerID, night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_VIGORMORTIS_[NIGHT%d]", night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            pushTempRule(rs);
-            /*
-            NO_DASHII
-            */
-            // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
-            setTempRuleParams(rs, 1,0);
-            for (int notKilledPlayerID = 0; notKilledPlayerID < NUM_PLAYERS; notKilledPlayerID++)
-            {
-                if (notKilledPlayerID != killedPlayerID)
-                {
-                    snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%d_[NIGHT%d]", notKilledPlayerID, night);
-                    setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-                }
-            }
-            snprintf(buff, STRING_BUFF_SIZE, "KILLED_%d_[NIGHT%d]", killedPlayerID, night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NO_DASHII_[NIGHT%d]", night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            pushTempRule(rs);
-            /*
-            VORTOX
-            */
-            // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
-            setTempRuleParams(rs, 1,0);
-            for (int notKilledPlayerID = 0; notKilledPlayerID < NUM_PLAYERS; notKilledPlayerID++)
-            {
-                if (notKilledPlayerID != killedPlayerID)
-                {
-                    snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%d_[NIGHT%d]", notKilledPlayerID, night);
-                    setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-                }
-            }
-            snprintf(buff, STRING_BUFF_SIZE, "KILLED_%d_[NIGHT%d]", killedPlayerID, night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_VORTOX_[NIGHT%d]", night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            pushTempRule(rs);
-            /*
-            ZOMBUUL
-            */
-            // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
-            setTempRuleParams(rs, 1,0);
-            for (int notKilledPlayerID = 0; notKilledPlayerID < NUM_PLAYERS; notKilledPlayerID++)
-            {
-                if (notKilledPlayerID != killedPlayerID)
-                {
-                    snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%d_[NIGHT%d]", notKilledPlayerID, night);
-                    setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-                }
-            }
-            snprintf(buff, STRING_BUFF_SIZE, "KILLED_%d_[NIGHT%d]", killedPlayerID, night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_ZOMBUUL_[NIGHT%d]", night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            pushTempRule(rs);
-            /*
-            NOTE: need to add more complex demons to this list
-            */
-
-        }
+        //Templates over the killed player, killing them means not killing anyone else
+        /*
+        IMP
+        */
+        // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
+        setTempRuleParams(rs, 1,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, -1);
+        snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%%d_[NIGHT%d]", night);
+        setOtherParamTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "KILLED_%%d_[NIGHT%d]", night);
+        addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+        snprintf(buff, STRING_BUFF_SIZE, "is_IMP_[NIGHT%d]", night);
+        addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
+        pushTempRule(rs);
+        /*
+        ASSASSIN
+        NOTE: this actually can only be triggered once per game
+        */
+        // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
+        setTempRuleParams(rs, 1,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, -1);
+        snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%%d_[NIGHT%d]", night);
+        setOtherParamTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "KILLED_%%d_[NIGHT%d]", night);
+        addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+        snprintf(buff, STRING_BUFF_SIZE, "is_ASSASSIN_[NIGHT%d]", night);
+        addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
+        pushTempRule(rs);
+        /*
+        FANG_GU
+        */
+        // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
+        setTempRuleParams(rs, 1,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, -1);
+        snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%%d_[NIGHT%d]", night);
+        setOtherParamTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "KILLED_%%d_[NIGHT%d]", night);
+        addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+        snprintf(buff, STRING_BUFF_SIZE, "is_FANG_GU_[NIGHT%d]", night);
+        addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
+        pushTempRule(rs);
+        /*
+        VIGORMORTIS
+        */
+        // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
+        setTempRuleParams(rs, 1,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, -1);
+        snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%%d_[NIGHT%d]", night);
+        setOtherParamTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "KILLED_%%d_[NIGHT%d]", night);
+        addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+        snprintf(buff, STRING_BUFF_SIZE, "is_VIGORMORTIS_[NIGHT%d]", night);
+        addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
+        pushTempRule(rs);
+        /*
+        NO_DASHII
+        */
+        // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
+        setTempRuleParams(rs, 1,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, -1);
+        snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%%d_[NIGHT%d]", night);
+        setOtherParamTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "KILLED_%%d_[NIGHT%d]", night);
+        addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NO_DASHII_[NIGHT%d]", night);
+        addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
+        pushTempRule(rs);
+        /*
+        VORTOX
+        */
+        // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
+        setTempRuleParams(rs, 1,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, -1);
+        snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%%d_[NIGHT%d]", night);
+        setOtherParamTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "KILLED_%%d_[NIGHT%d]", night);
+        addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+        snprintf(buff, STRING_BUFF_SIZE, "is_VORTOX_[NIGHT%d]", night);
+        addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
+        pushTempRule(rs);
+        /*
+        ZOMBUUL
+        */
+        // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> AND <PLAYER>is_IMP_NIGHT<i> =>  <PLAYER>NOT_KILLED_<PLAYER_Y>_NIGHT<i>
+        setTempRuleParams(rs, 1,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, -1);
+        snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%%d_[NIGHT%d]", night);
+        setOtherParamTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "KILLED_%%d_[NIGHT%d]", night);
+        addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+        snprintf(buff, STRING_BUFF_SIZE, "is_ZOMBUUL_[NIGHT%d]", night);
+        addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
+        pushTempRule(rs);
+        /*
+        NOTE: need to add more complex demons to this list
+        */
     
-        for (int playerID = 0; playerID < NUM_PLAYERS; playerID++)
-        {
-            
-            // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> => <PLAYER_X>SLEEP_DEATH_NIGHT<i> 
-            setTempRuleParams(rs, 2,0);
-            snprintf(buff, STRING_BUFF_SIZE, "SLEEP_DEATH_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, -1000-playerID, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "KILLED_%d_[NIGHT%d]", playerID, night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            pushTempRule(rs);
+        //Templates over the killed player PLAYER_X
+        // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> => <PLAYER_X>SLEEP_DEATH_NIGHT<i> 
+        setTempRuleParams(rs, 2,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, 1);
+        snprintf(buff, STRING_BUFF_SIZE, "SLEEP_DEATH_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 1, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "KILLED_%%d_[NIGHT%d]", night);
+        addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+        pushTempRule(rs);
 
-            // <PLAYER_X>NOT_SLEEP_DEATH_NIGHT<i> => <PLAYER>NOT_KILLED_<PLAYER_X>_NIGHT_<i>
-            setTempRuleParams(rs, 2,0);
-            snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%d_[NIGHT%d]", playerID, night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "NOT_SLEEP_DEATH_[NIGHT%d]", night);
-            addFixedConditionToTempRuleName(rs, kb, 1, "PLAYERS", buff, playerID);
-            pushTempRule(rs);
+        // <PLAYER_X>NOT_SLEEP_DEATH_NIGHT<i> => <PLAYER>NOT_KILLED_<PLAYER_X>_NIGHT_<i>
+        setTempRuleParams(rs, 2,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, 1);
+        snprintf(buff, STRING_BUFF_SIZE, "NOT_KILLED_%%d_[NIGHT%d]", night);
+        setParamTempRuleResultName(rs,kb, 0, "PLAYERS", buff, 0);
+        snprintf(buff, STRING_BUFF_SIZE, "NOT_SLEEP_DEATH_[NIGHT%d]", night);
+        addConditionToTempRuleName(rs, kb, 1, "PLAYERS", buff);
+        pushTempRule(rs);
 
-            // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> => <PLAYER>NOT_<ROLE THAT DOESN'T KILL>
-            setTempRuleParams(rs, 1,0);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARON_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SCARLET_WOMAN_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SPY_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_POISONER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_EVIL_TWIN_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_WITCH_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_CERENOVUS_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_DEVILS_ADVOCATE_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MASTERMIND_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_WASHERWOMAN_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_LIBRARIAN_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_INVESTIGATOR_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_CHEF_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_EMPATH_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_FORTUNE_TELLER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_UNDERTAKER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MONK_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_RAVENKEEPER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_VIRGIN_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SOLDIER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MAYOR_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_CLOCKMAKER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_DREAMER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MATHEMATICIAN_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_FLOWERGIRL_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_TOWN_CRIER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_ORACLE_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SAVANT_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SEAMSTRESS_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PHILOSOPHER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_ARTIST_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_JUGGLER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SAGE_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GRANDMOTHER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SAILOR_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_CHAMBERMAID_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_EXORCIST_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_INNKEEPER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GAMBLER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GOSSIP_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_COURTIER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PROFESSOR_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MINSTREL_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_TEA_LADY_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PACIFIST_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_FOOL_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BOUNTY_HUNTER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_ACROBAT_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_POPPY_GROWER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_VILLAGE_IDIOT_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BUTLER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_RECLUSE_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_DRUNK_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SAINT_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MUTANT_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SWEETHEART_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_KLUTZ_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_TINKER_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MOONCHILD_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GOON_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_LUNATIC_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
-            snprintf(buff, STRING_BUFF_SIZE, "is_NOT_POLITICIAN_[NIGHT%d]", night);
-            setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        // <PLAYER>KILLED_<PLAYER_X>_NIGHT<i> => <PLAYER>NOT_<ROLE THAT DOESN'T KILL>
+        setTempRuleParams(rs, 1,0);
+        setTempRuleTemplate(rs, NUM_PLAYERS, -1);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARON_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SCARLET_WOMAN_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SPY_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_POISONER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_EVIL_TWIN_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_WITCH_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_CERENOVUS_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PIT_HAG_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_DEVILS_ADVOCATE_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MASTERMIND_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_WASHERWOMAN_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_LIBRARIAN_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_INVESTIGATOR_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_CHEF_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_EMPATH_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_FORTUNE_TELLER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_UNDERTAKER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MONK_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_RAVENKEEPER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_VIRGIN_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SOLDIER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MAYOR_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_CLOCKMAKER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_DREAMER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SNAKE_CHARMER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MATHEMATICIAN_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_FLOWERGIRL_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_TOWN_CRIER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_ORACLE_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SAVANT_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SEAMSTRESS_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PHILOSOPHER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_ARTIST_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_JUGGLER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SAGE_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GRANDMOTHER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SAILOR_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_CHAMBERMAID_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_EXORCIST_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_INNKEEPER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GAMBLER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GOSSIP_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_COURTIER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PROFESSOR_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MINSTREL_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_TEA_LADY_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_PACIFIST_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_FOOL_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BOUNTY_HUNTER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_ACROBAT_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_POPPY_GROWER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_VILLAGE_IDIOT_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BUTLER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_RECLUSE_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_DRUNK_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SAINT_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MUTANT_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_SWEETHEART_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_BARBER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_KLUTZ_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_TINKER_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_MOONCHILD_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_GOON_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_LUNATIC_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
+        snprintf(buff, STRING_BUFF_SIZE, "is_NOT_POLITICIAN_[NIGHT%d]", night);
+        setTempRuleResultName(rs,kb, 0, "PLAYERS", buff);
 
-            snprintf(buff, STRING_BUFF_SIZE, "KILLED_%d_[NIGHT%d]", playerID, night);
-            addConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff);
-            pushTempRule(rs);
-        }
+        snprintf(buff, STRING_BUFF_SIZE, "KILLED_%%d_[NIGHT%d]", night);
+        addParamConditionToTempRuleName(rs, kb, 0, "PLAYERS", buff, 0);
+        pushTempRule(rs);
     }
 }
 /**
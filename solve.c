@@ -0,0 +1,867 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2025 Jacob Adams
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Headless solver, reads a game description and prints the role probabilities
+ *
+ * usage: botct-solve [-f json|csv] [-t seconds] [-w worlds] [-j threads] [-s seed] [-o output] [-b backtrack|sat] [-e] [game file]
+ *
+ * -b sat checks the game is consistent and finds witness worlds with the SAT solver instead of sampling,
+ * a non zero entry means the role is possible but the numbers are not probabilities.
+ * -e counts the night 0 worlds exactly instead of sampling
+ *
+ * The game description is read from the file given (or stdin), one command per line,
+ * '#' starts a comment. Players are given by name or by index, nights are numbers
+ *
+ *   script TB|SV|BMR|ALFIE (or 0-3)
+ *   players <n>
+ *   minions <n>
+ *   demons <n>
+ *   outsiders <n>                          (without a Baron)
+ *   names <name0> <name1> ...
+ *   seen <player> <role> <night>
+ *   options <player> <night> <role> <role> ...
+ *   notinplay <role> <night>
+ *   poisoned <player> <night>
+ *   healthy <player> <night>
+ *   redherring <player>
+ *   killed <player> <playerX> <night>
+ *   poisons <player> <playerX> <night>
+ *   died|nominated|hung|resurrected <night> <player> <player> ...
+ *   washerwoman|librarian|investigator <player> <role> <playerX> <playerY>
+ *   chef <player> <count>
+ *   empath <player> <count> <night>
+ *   fortuneteller <player> <count> <playerX> <playerY> <night>
+ *   undertaker|ravenkeeper <player> <role> <playerX> <night>
+ *   monk <player> <playerX> <night>
+ *   clockmaker <player> <steps>
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+//Multi-threading
+#include <pthread.h>
+
+#include "bitset.h"
+#include "rules.h"
+#include "knowledge.h"
+#include "constants.h"
+#include "scripts.h"
+#include "ui.h"
+#include "util.h"
+#include "solver.h"
+#include "sat.h"
+
+#define MAX_LINE_LENGTH 1024
+#define MAX_TOKENS 64
+#define MAX_THREADS 256
+
+const int NUM_ITERATIONS = 8;
+
+/*
+ * A game description read into memory, one command per line
+*/
+typedef struct {
+    char** LINES;
+    int NUM_LINES;
+    int CAPACITY;
+} GameDescription;
+
+/*
+ * Options from the command line
+*/
+typedef struct {
+    int csv;
+    double timeBudget;
+    long worldBudget;
+    int numThreads;
+    unsigned long seed;
+    char* inputPath;
+    char* outputPath;
+    int satBackend;
+    int exact;
+} SolveOptions;
+
+/**
+ * printUsage() - prints how to call the program and exits
+*/
+static void printUsage()
+{
+    fprintf(stderr, "usage: botct-solve [-f json|csv] [-t seconds] [-w worlds] [-j threads] [-s seed] [-o output] [-b backtrack|sat] [-e] [game file]\n");
+    fprintf(stderr, "  -b sat  check the game is consistent and find witness worlds with the SAT solver,\n");
+    fprintf(stderr, "          a non zero entry means the role is possible, the numbers are not probabilities\n");
+    fprintf(stderr, "  -e      count the night 0 worlds exactly instead of sampling\n");
+    exit(1);
+}
+
+/**
+ * parseOptions() - read the command line options
+ *
+ * @argc the number of arguments
+ * @argv the arguments
+ * @options OUTPUTS the options
+*/
+static void parseOptions(int argc, char* argv[], SolveOptions* options)
+{
+    options->csv = 0;
+    options->timeBudget = 0;
+    options->worldBudget = 0;
+    options->numThreads = 0; //One per hardware thread
+    options->seed = 0;
+    options->inputPath = NULL;
+    options->outputPath = NULL;
+    options->satBackend = 0;
+    options->exact = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "f:t:w:j:s:o:b:eh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f':
+                if (strcasecmp(optarg, "csv") == 0) options->csv = 1;
+                else if (strcasecmp(optarg, "json") == 0) options->csv = 0;
+                else printUsage();
+                break;
+            case 't':
+                options->timeBudget = atof(optarg);
+                break;
+            case 'w':
+                options->worldBudget = atol(optarg);
+                break;
+            case 'j':
+                options->numThreads = atoi(optarg);
+                if (options->numThreads < 0 || options->numThreads > MAX_THREADS) printUsage();
+                break;
+            case 's':
+                options->seed = strtoul(optarg, NULL, 10);
+                break;
+            case 'o':
+                options->outputPath = optarg;
+                break;
+            case 'b':
+                if (strcasecmp(optarg, "sat") == 0) options->satBackend = 1;
+                else if (strcasecmp(optarg, "backtrack") == 0) options->satBackend = 0;
+                else printUsage();
+                break;
+            case 'e':
+                options->exact = 1;
+                break;
+            default:
+                printUsage();
+        }
+    }
+    if (optind < argc) options->inputPath = argv[optind];
+
+    //Without any budget run for a fixed amount of time
+    if (options->timeBudget <= 0 && options->worldBudget <= 0) options->timeBudget = 10.0;
+}
+
+/**
+ * readGameDescription() - read every line of a game description into memory
+ *
+ * @file the file to read
+ * @game OUTPUTS the lines
+*/
+static void readGameDescription(FILE* file, GameDescription* game)
+{
+    char line[MAX_LINE_LENGTH];
+
+    game->NUM_LINES = 0;
+    game->CAPACITY = 64;
+    game->LINES = (char**) malloc(game->CAPACITY * sizeof(char*));
+    if (game->LINES == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+
+    while (fgets(line, MAX_LINE_LENGTH, file) != NULL)
+    {
+        //Strip comments
+        char* comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        if (game->NUM_LINES == game->CAPACITY)
+        {
+            game->CAPACITY *= 2;
+            game->LINES = (char**) realloc(game->LINES, game->CAPACITY * sizeof(char*));
+            if (game->LINES == NULL)
+            {
+                printf("MALLOC FAILED!\n");
+                exit(1);
+            }
+        }
+        game->LINES[game->NUM_LINES] = strdup(line);
+        game->NUM_LINES++;
+    }
+}
+
+/**
+ * tokenise() - split a line into whitespace seperated tokens
+ *
+ * @line the line to split (a copy is modified)
+ * @buff storage for the copy of the line
+ * @tokens OUTPUTS the tokens
+ *
+ * @return the number of tokens
+*/
+static int tokenise(char* line, char buff[MAX_LINE_LENGTH], char* tokens[MAX_TOKENS])
+{
+    snprintf(buff, MAX_LINE_LENGTH, "%s", line);
+
+    int numTokens = 0;
+    char* token = strtok(buff, " \t\r\n");
+    while (token != NULL && numTokens < MAX_TOKENS)
+    {
+        tokens[numTokens] = token;
+        numTokens++;
+        token = strtok(NULL, " \t\r\n");
+    }
+    return numTokens;
+}
+
+/**
+ * parseNumber() - read an integer, crash the program if it isn't one
+ *
+ * @lineNumber the line being read (for the error message)
+ * @token the string to read
+ * @min min number (inclusive)
+ * @max max number (exclusive)
+ *
+ * @return the number
+*/
+static int parseNumber(int lineNumber, char* token, int min, int max)
+{
+    char* end;
+    long value = strtol(token, &end, 10);
+    if (*end != '\0' || value < min || value >= max)
+    {
+        printf("ERROR: line %d, expected a number between %d and %d but found '%s'\n", lineNumber, min, max-1, token);
+        exit(1);
+    }
+    return (int) value;
+}
+
+/**
+ * parsePlayer() - read a player by name (or by index)
+ *
+ * @lineNumber the line being read (for the error message)
+ * @kb the knowledge base holding the player names
+ * @token the string to read
+ *
+ * @return the playerID/index
+*/
+static int parsePlayer(int lineNumber, KnowledgeBase* kb, char* token)
+{
+    for (int player = 0; player < kb->SET_SIZES[0]; player++)
+    {
+        if (strcasecmp(token, kb->SCHEMA->ELEMENT_NAMES[0][player]) == 0) return player;
+    }
+    return parseNumber(lineNumber, token, 0, kb->SET_SIZES[0]);
+}
+
+/**
+ * parseRole() - read a role in the script by name
+ *
+ * @lineNumber the line being read (for the error message)
+ * @token the string to read
+ *
+ * @return the roleID/index
+*/
+static int parseRole(int lineNumber, char* token)
+{
+    int roleID = getRoleIdFromString(token);
+    if (roleID == -1)
+    {
+        printf("ERROR: line %d, '%s' is not a role in the script\n", lineNumber, token);
+        exit(1);
+    }
+    return roleID;
+}
+
+/**
+ * parseScript() - read a script by name (or by index)
+ *
+ * @lineNumber the line being read (for the error message)
+ * @token the string to read
+ *
+ * @return the scriptID
+*/
+static int parseScript(int lineNumber, char* token)
+{
+    if (strcasecmp(token, "TB") == 0) return 0;
+    if (strcasecmp(token, "SV") == 0) return 1;
+    if (strcasecmp(token, "BMR") == 0) return 2;
+    if (strcasecmp(token, "ALFIE") == 0) return 3;
+    return parseNumber(lineNumber, token, 0, 4);
+}
+
+/**
+ * expectTokens() - crash the program if a command has too few arguments
+ *
+ * @lineNumber the line being read (for the error message)
+ * @numTokens the number of tokens on the line
+ * @expected the number of tokens needed
+*/
+static void expectTokens(int lineNumber, int numTokens, int expected)
+{
+    if (numTokens < expected)
+    {
+        printf("ERROR: line %d, expected %d arguments but found %d\n", lineNumber, expected-1, numTokens-1);
+        exit(1);
+    }
+}
+
+/**
+ * readSetup() - read the setup commands of a game description
+ *
+ * @game the game description
+ * @numPlayers OUTPUTS the number of players in the game
+ * @numMinions OUTPUTS the number of base starting minions in the game
+ * @numDemons OUTPUTS the number of base starting demons in the game
+ * @baseOutsiders OUTPUTS the number of base starting outsiders in the game
+ * @script OUTPUTS the scriptID
+*/
+static void readSetup(GameDescription* game, int *numPlayers, int *numMinions, int *numDemons, int *baseOutsiders, int *script)
+{
+    char buff[MAX_LINE_LENGTH];
+    char* tokens[MAX_TOKENS];
+
+    *script = -1;
+    *numPlayers = -1;
+    *numMinions = -1;
+    *numDemons = -1;
+    *baseOutsiders = -1;
+
+    for (int line = 0; line < game->NUM_LINES; line++)
+    {
+        int numTokens = tokenise(game->LINES[line], buff, tokens);
+        if (numTokens == 0) continue;
+
+        //Same limits as setup()
+        if (strcasecmp(tokens[0], "script") == 0)
+        {
+            expectTokens(line+1, numTokens, 2);
+            *script = parseScript(line+1, tokens[1]);
+        }
+        else if (strcasecmp(tokens[0], "players") == 0)
+        {
+            expectTokens(line+1, numTokens, 2);
+            *numPlayers = parseNumber(line+1, tokens[1], 3, 17);
+        }
+        else if (strcasecmp(tokens[0], "minions") == 0)
+        {
+            expectTokens(line+1, numTokens, 2);
+            *numMinions = parseNumber(line+1, tokens[1], 0, 5);
+        }
+        else if (strcasecmp(tokens[0], "demons") == 0)
+        {
+            expectTokens(line+1, numTokens, 2);
+            *numDemons = parseNumber(line+1, tokens[1], 0, 5);
+        }
+        else if (strcasecmp(tokens[0], "outsiders") == 0)
+        {
+            expectTokens(line+1, numTokens, 2);
+            *baseOutsiders = parseNumber(line+1, tokens[1], 0, 5);
+        }
+    }
+
+    if (*script == -1 || *numPlayers == -1 || *numMinions == -1 || *numDemons == -1 || *baseOutsiders == -1)
+    {
+        printf("ERROR: the game description must give a script, players, minions, demons and outsiders\n");
+        exit(1);
+    }
+}
+
+/**
+ * readEvents() - apply the names and observed events of a game description
+ *
+ * @game the game description
+ * @kb the knowledge base to update
+ * @rs the ruleset to update
+*/
+static void readEvents(GameDescription* game, KnowledgeBase* kb, RuleSet* rs)
+{
+    char buff[MAX_LINE_LENGTH];
+    char* tokens[MAX_TOKENS];
+    int playerIDs[MAX_SET_ELEMENTS];
+    int roleIDs[NUM_BOTCT_ROLES];
+
+    for (int player = 0; player < kb->SET_SIZES[0]; player++)
+    {
+        snprintf(kb->SCHEMA->ELEMENT_NAMES[0][player], STRING_BUFF_SIZE, "PLAYER%d", player);
+    }
+
+    for (int line = 0; line < game->NUM_LINES; line++)
+    {
+        int numTokens = tokenise(game->LINES[line], buff, tokens);
+        if (numTokens == 0) continue;
+
+        int n = line+1;
+        char* command = tokens[0];
+
+        if (strcasecmp(command, "script") == 0 || strcasecmp(command, "players") == 0
+            || strcasecmp(command, "minions") == 0 || strcasecmp(command, "demons") == 0
+            || strcasecmp(command, "outsiders") == 0)
+        {
+            //Already read by readSetup()
+        }
+        else if (strcasecmp(command, "names") == 0)
+        {
+            expectTokens(n, numTokens, kb->SET_SIZES[0]+1);
+            for (int player = 0; player < kb->SET_SIZES[0]; player++)
+            {
+                snprintf(kb->SCHEMA->ELEMENT_NAMES[0][player], STRING_BUFF_SIZE, "%s", tokens[player+1]);
+            }
+        }
+        else if (strcasecmp(command, "seen") == 0)
+        {
+            expectTokens(n, numTokens, 4);
+            shown_role(kb, parsePlayer(n, kb, tokens[1]), parseRole(n, tokens[2]), parseNumber(n, tokens[3], 0, NUM_DAYS));
+        }
+        else if (strcasecmp(command, "options") == 0)
+        {
+            expectTokens(n, numTokens, 4);
+            int count = 0;
+            for (int i = 3; i < numTokens && count < NUM_BOTCT_ROLES; i++)
+            {
+                roleIDs[count] = parseRole(n, tokens[i]);
+                count++;
+            }
+            noptions(kb, parsePlayer(n, kb, tokens[1]), count, roleIDs, parseNumber(n, tokens[2], 0, NUM_DAYS));
+        }
+        else if (strcasecmp(command, "notinplay") == 0)
+        {
+            expectTokens(n, numTokens, 3);
+            roleNotInGame(kb, parseRole(n, tokens[1]), parseNumber(n, tokens[2], 0, NUM_DAYS));
+        }
+        else if (strcasecmp(command, "poisoned") == 0)
+        {
+            expectTokens(n, numTokens, 3);
+            poisoned(kb, parsePlayer(n, kb, tokens[1]), parseNumber(n, tokens[2], 0, NUM_DAYS));
+        }
+        else if (strcasecmp(command, "healthy") == 0)
+        {
+            expectTokens(n, numTokens, 3);
+            notPoisoned(kb, parsePlayer(n, kb, tokens[1]), parseNumber(n, tokens[2], 0, NUM_DAYS));
+        }
+        else if (strcasecmp(command, "redherring") == 0)
+        {
+            expectTokens(n, numTokens, 2);
+            redHerring(kb, parsePlayer(n, kb, tokens[1]));
+        }
+        else if (strcasecmp(command, "killed") == 0)
+        {
+            expectTokens(n, numTokens, 4);
+            killedPlayer(kb, parsePlayer(n, kb, tokens[1]), parsePlayer(n, kb, tokens[2]), parseNumber(n, tokens[3], 0, NUM_DAYS));
+        }
+        else if (strcasecmp(command, "poisons") == 0)
+        {
+            expectTokens(n, numTokens, 4);
+            hasPoisoned(kb, parsePlayer(n, kb, tokens[1]), parsePlayer(n, kb, tokens[2]), parseNumber(n, tokens[3], 0, NUM_DAYS));
+        }
+        else if (strcasecmp(command, "died") == 0 || strcasecmp(command, "nominated") == 0
+            || strcasecmp(command, "hung") == 0 || strcasecmp(command, "resurrected") == 0)
+        {
+            expectTokens(n, numTokens, 3);
+            int night = parseNumber(n, tokens[1], 0, NUM_DAYS);
+            int count = 0;
+            for (int i = 2; i < numTokens && count < MAX_SET_ELEMENTS; i++)
+            {
+                playerIDs[count] = parsePlayer(n, kb, tokens[i]);
+                count++;
+            }
+            if (strcasecmp(command, "died") == 0) diedInNight(kb, count, playerIDs, night);
+            else if (strcasecmp(command, "nominated") == 0) nominationDeath(kb, count, playerIDs, night);
+            else if (strcasecmp(command, "hung") == 0) hung(kb, count, playerIDs, night);
+            else resurrected(kb, count, playerIDs, night);
+        }
+        else if (strcasecmp(command, "washerwoman") == 0)
+        {
+            expectTokens(n, numTokens, 5);
+            washerWomanPing(parsePlayer(n, kb, tokens[1]), parseRole(n, tokens[2]), parsePlayer(n, kb, tokens[3]), parsePlayer(n, kb, tokens[4]), kb, rs);
+        }
+        else if (strcasecmp(command, "librarian") == 0)
+        {
+            expectTokens(n, numTokens, 5);
+            librarianPing(parsePlayer(n, kb, tokens[1]), parseRole(n, tokens[2]), parsePlayer(n, kb, tokens[3]), parsePlayer(n, kb, tokens[4]), kb, rs);
+        }
+        else if (strcasecmp(command, "investigator") == 0)
+        {
+            expectTokens(n, numTokens, 5);
+            investigatorPing(parsePlayer(n, kb, tokens[1]), parseRole(n, tokens[2]), parsePlayer(n, kb, tokens[3]), parsePlayer(n, kb, tokens[4]), kb, rs);
+        }
+        else if (strcasecmp(command, "chef") == 0)
+        {
+            expectTokens(n, numTokens, 3);
+            chefPing(parsePlayer(n, kb, tokens[1]), parseNumber(n, tokens[2], 0, MAX_SET_ELEMENTS), kb, rs);
+        }
+        else if (strcasecmp(command, "empath") == 0)
+        {
+            expectTokens(n, numTokens, 4);
+            empathPing(parsePlayer(n, kb, tokens[1]), parseNumber(n, tokens[2], 0, 3), parseNumber(n, tokens[3], 0, NUM_DAYS), kb, rs);
+        }
+        else if (strcasecmp(command, "fortuneteller") == 0)
+        {
+            expectTokens(n, numTokens, 6);
+            fortuneTellerPing(parsePlayer(n, kb, tokens[1]), parseNumber(n, tokens[2], 0, 2), parsePlayer(n, kb, tokens[3]), parsePlayer(n, kb, tokens[4]), parseNumber(n, tokens[5], 0, NUM_DAYS), kb, rs);
+        }
+        else if (strcasecmp(command, "undertaker") == 0)
+        {
+            expectTokens(n, numTokens, 5);
+            undertakerPing(parsePlayer(n, kb, tokens[1]), parseRole(n, tokens[2]), parsePlayer(n, kb, tokens[3]), parseNumber(n, tokens[4], 0, NUM_DAYS), kb, rs);
+        }
+        else if (strcasecmp(command, "ravenkeeper") == 0)
+        {
+            expectTokens(n, numTokens, 5);
+            ravenkeeperPing(parsePlayer(n, kb, tokens[1]), parseRole(n, tokens[2]), parsePlayer(n, kb, tokens[3]), parseNumber(n, tokens[4], 0, NUM_DAYS), kb, rs);
+        }
+        else if (strcasecmp(command, "monk") == 0)
+        {
+            expectTokens(n, numTokens, 4);
+            monkPing(parsePlayer(n, kb, tokens[1]), parsePlayer(n, kb, tokens[2]), parseNumber(n, tokens[3], 0, NUM_DAYS), kb, rs);
+        }
+        else if (strcasecmp(command, "clockmaker") == 0)
+        {
+            expectTokens(n, numTokens, 3);
+            clockmakerPing(parsePlayer(n, kb, tokens[1]), parseNumber(n, tokens[2], 0, MAX_SET_ELEMENTS), kb, rs);
+        }
+        else
+        {
+            printf("ERROR: line %d, unknown command '%s'\n", n, command);
+            exit(1);
+        }
+    }
+}
+
+/**
+ * getSeconds() - monotonic time in seconds
+ *
+ * @return the time
+*/
+static double getSeconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * getRoleProbability() - the fraction of sampled worlds where a player has a role
+ *
+ * @kb the knowledge base
+ * @tally the sampled worlds
+ * @player the playerID/index
+ * @roleFunctions the functionID/index of is_<ROLE>_[NIGHT<night>]
+ *
+ * @return 0 <= P <= 1, or NAN if no worlds were sampled
+*/
+static double getRoleProbability(KnowledgeBase* kb, ProbKnowledgeBase* tally, int player, int roleFunction)
+{
+    if (isKnown(kb, 0, player, roleFunction)) return 1.0;
+    if (isKnown(kb, 0, player, roleFunction^1)) return 0.0;
+    if (tally->tally <= 0) return NAN;
+    return getProbTally(tally, 0, player, roleFunction) / tally->tally;
+}
+
+/**
+ * printJSONString() - print a string as a quoted JSON string
+ *
+ * @out the file to print to
+ * @str the string
+*/
+static void printJSONString(FILE* out, char* str)
+{
+    fputc('"', out);
+    for (char* c = str; *c != '\0'; c++)
+    {
+        if ((unsigned char) *c < 0x20) fprintf(out, "\\u%04x", (unsigned char) *c); //Control characters must be escaped
+        else if (*c == '"' || *c == '\\') fprintf(out, "\\%c", *c);
+        else fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+/**
+ * printCSVField() - print a string as a CSV field (RFC 4180),
+ * quoted with its quotes doubled if it has a comma, quote or line break
+ *
+ * @out the file to print to
+ * @str the string
+*/
+static void printCSVField(FILE* out, char* str)
+{
+    if (strpbrk(str, ",\"\r\n") == NULL)
+    {
+        fputs(str, out);
+        return;
+    }
+    fputc('"', out);
+    for (char* c = str; *c != '\0'; c++)
+    {
+        if (*c == '"') fputc('"', out);
+        fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+/**
+ * printProbability() - print a probability, null if it is unknown
+ *
+ * @out the file to print to
+ * @p the probability
+*/
+static void printProbability(FILE* out, double p)
+{
+    if (isnan(p)) fprintf(out, "null");
+    else fprintf(out, "%.6f", p);
+}
+
+/**
+ * printResultsJSON() - print the probability tables as JSON
+ *
+ * @out the file to print to
+ * @kb the knowledge base
+ * @tally the sampled worlds
+ * @seed the seed of the first sampler
+ * @seconds how long was spent sampling
+ * @numNights the number of nights to print
+ * @exact -1 if the worlds were sampled (the seed is printed),
+ * otherwise if every world was counted (see getProbExact(), the seed is meaningless)
+*/
+static void printResultsJSON(FILE* out, KnowledgeBase* kb, ProbKnowledgeBase* tally, unsigned long seed, double seconds, int numNights, int exact)
+{
+    char buff[STRING_BUFF_SIZE];
+
+    fprintf(out, "{\n");
+    if (exact == -1) fprintf(out, "  \"seed\": %lu,\n", seed);
+    else fprintf(out, "  \"exact\": %s,\n", exact ? "true" : "false");
+    fprintf(out, "  \"seconds\": %.3f,\n", seconds);
+    fprintf(out, "  \"worlds\": %ld,\n", tally->numWorlds);
+    fprintf(out, "  \"nights\": [\n");
+    for (int night = 0; night < numNights; night++)
+    {
+        fprintf(out, "    {\n      \"night\": %d,\n      \"players\": [\n", night);
+        for (int player = 0; player < kb->SET_SIZES[0]; player++)
+        {
+            fprintf(out, "        {\"name\": ");
+            printJSONString(out, kb->SCHEMA->ELEMENT_NAMES[0][player]);
+            fprintf(out, ", \"roles\": {");
+            int first = 1;
+            for (int role = 0; role < NUM_BOTCT_ROLES; role++)
+            {
+                if (ROLE_IN_SCRIPT[role] == 0) continue;
+                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
+                int function = getSetFunctionIDWithName(kb, 0, buff, 1);
+                if (first == 0) fprintf(out, ", ");
+                first = 0;
+                printJSONString(out, ROLE_NAMES[role]);
+                fprintf(out, ": ");
+                printProbability(out, getRoleProbability(kb, tally, player, function));
+            }
+            fprintf(out, "}}%s\n", player == kb->SET_SIZES[0]-1 ? "" : ",");
+        }
+        fprintf(out, "      ]\n    }%s\n", night == numNights-1 ? "" : ",");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+/**
+ * printResultsCSV() - print the probability tables as CSV, one row per (night, player, role)
+ *
+ * @out the file to print to
+ * @kb the knowledge base
+ * @tally the sampled worlds
+ * @numNights the number of nights to print
+*/
+static void printResultsCSV(FILE* out, KnowledgeBase* kb, ProbKnowledgeBase* tally, int numNights)
+{
+    char buff[STRING_BUFF_SIZE];
+
+    fprintf(out, "night,player,role,probability\n");
+    for (int night = 0; night < numNights; night++)
+    {
+        for (int player = 0; player < kb->SET_SIZES[0]; player++)
+        {
+            for (int role = 0; role < NUM_BOTCT_ROLES; role++)
+            {
+                if (ROLE_IN_SCRIPT[role] == 0) continue;
+                snprintf(buff, STRING_BUFF_SIZE, "is_%s_[NIGHT%d]", ROLE_NAMES[role], night);
+                int function = getSetFunctionIDWithName(kb, 0, buff, 1);
+                double p = getRoleProbability(kb, tally, player, function);
+                fprintf(out, "%d,", night);
+                printCSVField(out, kb->SCHEMA->ELEMENT_NAMES[0][player]);
+                fputc(',', out);
+                printCSVField(out, ROLE_NAMES[role]);
+                fputc(',', out);
+                if (!isnan(p)) fprintf(out, "%.6f", p);
+                fprintf(out, "\n");
+            }
+        }
+    }
+}
+
+//make botct-solve
+int main(int argc, char* argv[])
+{
+    SolveOptions options;
+    parseOptions(argc, argv, &options);
+
+    //Results go to the real stdout, everything the solver prints goes to stderr
+    FILE* out;
+    if (options.outputPath != NULL)
+    {
+        out = fopen(options.outputPath, "w");
+    }
+    else
+    {
+        out = fdopen(dup(STDOUT_FILENO), "w");
+    }
+    if (out == NULL)
+    {
+        fprintf(stderr, "ERROR: could not open the output\n");
+        return 1;
+    }
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+
+    FILE* in = stdin;
+    if (options.inputPath != NULL) in = fopen(options.inputPath, "r");
+    if (in == NULL)
+    {
+        printf("ERROR: could not open '%s'\n", options.inputPath);
+        return 1;
+    }
+    GameDescription game;
+    readGameDescription(in, &game);
+    if (in != stdin) fclose(in);
+
+    //Variables
+    int NUM_PLAYERS;
+    int NUM_MINIONS;
+    int NUM_DEMONS;
+    int BASE_OUTSIDERS;
+    int SCRIPT;
+    readSetup(&game, &NUM_PLAYERS, &NUM_MINIONS, &NUM_DEMONS, &BASE_OUTSIDERS, &SCRIPT);
+
+    RuleSet* RULE_SET = NULL;
+    KnowledgeBase* KNOWLEDGE_BASE = NULL;
+    initScript(&RULE_SET, &KNOWLEDGE_BASE, SCRIPT, NUM_PLAYERS, NUM_MINIONS, NUM_DEMONS, BASE_OUTSIDERS);
+
+    readEvents(&game, KNOWLEDGE_BASE, RULE_SET);
+
+    if (inferImplicitFacts(KNOWLEDGE_BASE, RULE_SET, NUM_SOLVE_STEPS, 0))
+    {
+        printf("CONTRADICTION FOUND!\n");
+        return 2;
+    }
+    //Same set up as the UI, the samplers start parked so they can help with the probes
+    atomic_int WORLD_GENERATION = 1;
+    bool reRenderCall = false;
+    unsigned long seed = options.seed != 0 ? options.seed : (unsigned long) time(NULL);
+    CachedKnowledgeBases* POSSIBLE_WORLDS_FOR_PROB = initCachedKB(KNOWLEDGE_BASE, MAX_CACHED_WORLDS, seed);
+    SamplerPool* pool = initSamplerPool(options.numThreads);
+
+    struct getProbApproxArgs samplerArgs;
+    samplerArgs.kb = KNOWLEDGE_BASE; //We MUST promise to never touch this in the thread
+    samplerArgs.POSSIBLE_WORLDS_FOR_PROB = POSSIBLE_WORLDS_FOR_PROB;
+    samplerArgs.worldGeneration = &WORLD_GENERATION;
+    samplerArgs.reRenderCall = &reRenderCall;
+    samplerArgs.ruleSets = initVersionedRuleSet(RULE_SET, pool->NUM_THREADS);
+    samplerArgs.numIterations = NUM_ITERATIONS;
+    samplerArgs.seed = seed;
+    samplerArgs.verbose = 0;
+    samplerArgs.satBackend = options.satBackend;
+    pauseSamplerPool(pool);
+    startSamplerPool(pool, &samplerArgs);
+
+    if (probeRoleFacts(KNOWLEDGE_BASE, RULE_SET, pool) == -1)
+    {
+        printf("CONTRADICTION FOUND!\n");
+        return 2;
+    }
+    optimiseRuleset(RULE_SET, KNOWLEDGE_BASE);
+    //Inference alone can miss contradictions the SAT solver finds
+    if ((options.satBackend || options.exact) && !isConsistentSat(RULE_SET, KNOWLEDGE_BASE))
+    {
+        printf("CONTRADICTION FOUND!\n");
+        return 2;
+    }
+
+    //Small games can be counted instead of sampled
+    if (options.exact)
+    {
+        ProbKnowledgeBase* EXACT_TALLY = initProbKB(KNOWLEDGE_BASE);
+        double start = getSeconds();
+        int exact = getProbExact(KNOWLEDGE_BASE, RULE_SET, EXACT_TALLY, options.worldBudget, options.timeBudget);
+        double seconds = getSeconds() - start;
+        //Only night 0 is counted, later nights come from a single world for each combination
+        if (options.csv) printResultsCSV(out, KNOWLEDGE_BASE, EXACT_TALLY, 1);
+        else printResultsJSON(out, KNOWLEDGE_BASE, EXACT_TALLY, 0, seconds, 1, exact);
+        fflush(out);
+        printf("Counted %ld worlds in %.3f seconds\n", EXACT_TALLY->numWorlds, seconds);
+        if (!exact) printf("The budget ran out (or the SAT solver kept giving up) before every world was counted, the probabilities are NOT exact\n");
+        return exact ? 0 : 3;
+    }
+
+    //Samplers pin the probed and optimised rules when they see the generation change,
+    //then the main thread only waits for the budget
+    publishRuleSet(samplerArgs.ruleSets, RULE_SET);
+    WORLD_GENERATION++;
+    ProbKnowledgeBase* WORLD_TALLY = initProbKB(KNOWLEDGE_BASE);
+    printf("Sampling worlds with seed %lu on %d threads using %s bitset kernels\n", seed, pool->NUM_THREADS, getBitsetKernelsName());
+    double start = getSeconds();
+    resumeSamplerPool(pool);
+
+    //Wait until the time or world budget runs out
+    struct timespec poll = {0, 10000000};
+    while (1)
+    {
+        nanosleep(&poll, NULL);
+        sumPublishedTallies(WORLD_TALLY, NULL, pool->PUBLISHED_TALLIES, pool->NUM_THREADS, WORLD_GENERATION);
+        long worlds = WORLD_TALLY->numWorlds;
+
+        double elapsed = getSeconds() - start;
+        if (options.timeBudget > 0 && elapsed >= options.timeBudget) break;
+        if (options.worldBudget > 0 && worlds >= options.worldBudget) break;
+    }
+
+    //Print the tally as of the last poll, parked samplers don't compete with printing
+    pauseSamplerPool(pool);
+    double seconds = getSeconds() - start;
+    if (options.csv) printResultsCSV(out, KNOWLEDGE_BASE, WORLD_TALLY, NUM_DAYS);
+    else printResultsJSON(out, KNOWLEDGE_BASE, WORLD_TALLY, seed, seconds, NUM_DAYS, -1);
+    fflush(out);
+    printf("Sampled %ld worlds in %.3f seconds\n", WORLD_TALLY->numWorlds, seconds);
+
+    //The samplers loop forever, exiting the process stops them
+    exit(0);
+}
@@ -25,9 +25,12 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
+#include <time.h>
 
 //Multi-threading
 #include <pthread.h>
+#include <sched.h>
 
 #include "rules.h"
 #include "knowledge.h"
@@ -36,8 +39,10 @@
 #include "ui.h"
 #include "util.h"
 #include "solver.h"
-#include "uitest.h"
+#include "sat.h"
 
+pthread_mutex_t exampleworldlock = PTHREAD_MUTEX_INITIALIZER; // Mutex to protect shared data
+pthread_mutex_t cacheworldlock = PTHREAD_MUTEX_INITIALIZER;
 
 /**
  * inferImplicitFacts() - helper function to iterate inferknowledgeBaseFromRules()
@@ -52,24 +57,69 @@
 */
 int inferImplicitFacts(KnowledgeBase* kb, RuleSet* rs, int numRounds, int verbose)
 {
-    //Loop for a maximum number of rounds
-    for (int i = 0; i < numRounds; i++)
-    {
-        int result = inferknowledgeBaseFromRules(rs, kb, verbose);
+    if (numRounds <= 0) return 0;
+
+    //Rules only check the words they change for contradictions so check everything else once
+    if (hasExplicitContradiction(kb)) return 1;
+
+    //First round checks every rule
+    long changedWords[NUM_SETS] = {0};
+    int result = inferknowledgeBaseFromRules(rs, kb, verbose, changedWords);
+
+    if (result == -1) return 1; //Check for contradictions
+    if (result == 0) return 0; //If nothing new was found
+
+    //Later rounds only need to check rules watching what changed
+    if (inferknowledgeBaseFromRulesIncremental(rs, kb, changedWords, numRounds-1, verbose) == -1) return 1;
+
+    //No contradictions were found
+    return 0;
+}
+
+/**
+ * inferImplicitFactsIncremental() - helper function to run inferknowledgeBaseFromRulesIncremental()
+ * after a few facts have been added to an already infered knowledge base
+ * 
+ * @kb the knoweledge base
+ * @rs the ruleset object
+ * @changedWords the words changed since the knowledge base was last infered (see markFunctionChanged())
+ * @numRounds the maximium number of infer steps (less steps may be taken if a contradiction is found early or if no new information is found)
+ * @verbose if 1 print results
+ * 
+ * @return TRUE if a contradiction was found
+*/
+int inferImplicitFactsIncremental(KnowledgeBase* kb, RuleSet* rs, long changedWords[NUM_SETS], int numRounds, int verbose)
+{
+    //A fact can contradict the knowledge base without any rule firing
+    //only the changed words can hold a new contradiction
+    if (hasContradictionInChangedWords(kb, changedWords)) return 1;
+
+    if (inferknowledgeBaseFromRulesIncremental(rs, kb, changedWords, numRounds, verbose) == -1) return 1;
 
-        if (result == -1) return 1; //Check for contradictions
-        if (result == 0) break; //If nothing new was found
-    }
     //No contradictions were found
     return 0;
 }
 
 #define MAX_FALIURES 1024
 
+/**
+ * isStaleGeneration() - check if the knowledge base changed since a sampler started its search
+ * cheap enough to call at every backtracking step
+ * 
+ * @myGeneration the world generation the search started in
+ * @worldGeneration the current world generation
+ * 
+ * @return TRUE if the search is stale
+*/
+static inline int isStaleGeneration(int myGeneration, atomic_int* worldGeneration)
+{
+    return myGeneration != atomic_load_explicit(worldGeneration, memory_order_relaxed);
+}
+
 static int assignPoisonForWorld(
-    KnowledgeBase* possibleWorldKB, KnowledgeBase**** possibleWorldRevertKB, 
+    KnowledgeBase* possibleWorldKB, 
     ProbKnowledgeBase* determinedInNWorlds, 
-    RuleSet* rs, 
+    RuleSet* rs, RandState* rng, 
     int avaliable[5][MAX_SET_ELEMENTS][3], 
     int night, int playerIndex, 
     int *failures, 
@@ -77,13 +127,14 @@ static int assignPoisonForWorld(
     int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], 
     int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], 
     int isPoisonedIndexes[NUM_DAYS], int isNotPoisonedIndexes[NUM_DAYS],
-    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS]
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
+    int myGeneration, atomic_int* worldGeneration
 );
 
 static int assignKillForWorld(
-    KnowledgeBase* possibleWorldKB, KnowledgeBase**** possibleWorldRevertKB, 
+    KnowledgeBase* possibleWorldKB, 
     ProbKnowledgeBase* determinedInNWorlds, 
-    RuleSet* rs, 
+    RuleSet* rs, RandState* rng, 
     int avaliable[5][MAX_SET_ELEMENTS][3], 
     int night, int playerIndex, 
     int *failures, 
@@ -91,13 +142,14 @@ static int assignKillForWorld(
     int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], 
     int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
     int isPoisonedIndexes[NUM_DAYS], int isNotPoisonedIndexes[NUM_DAYS], 
-    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS]
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
+    int myGeneration, atomic_int* worldGeneration
 );
 
 static int assignRoleForWorld(
-    KnowledgeBase* possibleWorldKB, KnowledgeBase**** possibleWorldRevertKB, 
+    KnowledgeBase* possibleWorldKB, 
     ProbKnowledgeBase* determinedInNWorlds, 
-    RuleSet* rs, 
+    RuleSet* rs, RandState* rng, 
     int avaliable[5][MAX_SET_ELEMENTS][3], 
     int night, int playerIndex, 
     int *failures, 
@@ -105,13 +157,14 @@ static int assignRoleForWorld(
     int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], 
     int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], 
     int isPoisonedIndexes[NUM_DAYS], int isNotPoisonedIndexes[NUM_DAYS],
-    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS]
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
+    int myGeneration, atomic_int* worldGeneration
 );
 
 static int assignPoisonForWorld(
-    KnowledgeBase* possibleWorldKB, KnowledgeBase**** possibleWorldRevertKB, 
+    KnowledgeBase* possibleWorldKB, 
     ProbKnowledgeBase* determinedInNWorlds, 
-    RuleSet* rs, 
+    RuleSet* rs, RandState* rng, 
     int avaliable[5][MAX_SET_ELEMENTS][3], 
     int night, int playerIndex, 
     int *failures, 
@@ -119,39 +172,44 @@ static int assignPoisonForWorld(
     int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], 
     int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
     int isPoisonedIndexes[NUM_DAYS], int isNotPoisonedIndexes[NUM_DAYS],
-    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS]
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
+    int myGeneration, atomic_int* worldGeneration
 )
 {
     //Choose player from random permutation to remove certain biases in allocation
     int player = permute[playerIndex];
 
-    KnowledgeBase* myLayerRevertKB = possibleWorldRevertKB[night][player][2];
-
-    int avaliableActions = 0;
     int actionsAvalaliable[NUM_BOTCT_ROLES];
 
     //You can always pick the "do nothing" action
     actionsAvalaliable[0] = 1;
-    avaliableActions++;
     for (int playerToAction = 0; playerToAction < possibleWorldKB->SET_SIZES[0]; playerToAction++)
     {
         int notPoisonedPlayers = isKnown(possibleWorldKB, 0, player, notPoisonedIndexes[night][playerToAction]);
 
         int roleAvaliable = notPoisonedPlayers ? 0 : 1;
         actionsAvalaliable[playerToAction+1] = roleAvaliable;
-        avaliableActions += roleAvaliable;
     }
+    RandChoices choices;
+    initRandChoices(&choices, actionsAvalaliable, possibleWorldKB->SET_SIZES[0]+1);
 
-    copyTo(myLayerRevertKB, possibleWorldKB); //copy to backup to revert later
+    int trailMark = getTrailMark(possibleWorldKB); //mark the trail to revert later
 
-    while (avaliableActions > 0)
+    while (choices.TOTAL > 0)
     {
-        int playerToActionID = getRandIntNotIn(actionsAvalaliable, avaliableActions);
+        //The knowledge base changed so this world is stale, stop searching
+        if (isStaleGeneration(myGeneration, worldGeneration)) return -1;
+
+        int playerToActionID = getRandChoice(rng, &choices);
+
+        //Track what is assumed so only rules watching it need checking
+        long changedWords[NUM_SETS] = {0};
 
         //Assume true
         if (playerToActionID != 0)
         {
             addKnowledge(possibleWorldKB, 0, player, poisonedIndexes[night][playerToActionID-1]);
+            markFunctionChanged(changedWords, 0, poisonedIndexes[night][playerToActionID-1]);
         }
 
         if (playerIndex+1 >= possibleWorldKB->SET_SIZES[0])
@@ -165,6 +223,7 @@ static int assignPoisonForWorld(
                     if (poisonedPlayers == 0)
                     {
                         addKnowledge(possibleWorldKB, 0, playerID, notPoisonedIndexes[night][poisonedPlayerID]);
+                        markFunctionChanged(changedWords, 0, notPoisonedIndexes[night][poisonedPlayerID]);
                     }
                     else
                     {
@@ -174,13 +233,14 @@ static int assignPoisonForWorld(
                 if (playerPoisoned == 0)
                 { //Add code to say the player isn't poisoned
                     addKnowledge(possibleWorldKB, 0, poisonedPlayerID, isNotPoisonedIndexes[night]);
+                    markFunctionChanged(changedWords, 0, isNotPoisonedIndexes[night]);
                 }
             }
         }
             
 
         //Infer knowledge (to see if a contradiction arises)
-        if (inferImplicitFacts(possibleWorldKB, rs, NUM_SOLVE_STEPS, 0))
+        if (inferImplicitFactsIncremental(possibleWorldKB, rs, changedWords, NUM_SOLVE_STEPS, 0))
         { //If contradiction found by only adding "function" to assumptions we know NOT function is true 
             *failures = *failures+1;
             if (*failures > MAX_FALIURES) return -1;
@@ -189,10 +249,7 @@ static int assignPoisonForWorld(
         { //If I found a role to assign, try deeper layers
             //Find out how many roles are avaliable 
             //used for computing weights basic on non uniform probabilities later
-            avaliable[night][player][2] = 0;
-
-            //Swapped out for faster code;
-            for (int i = 0; i < possibleWorldKB->SET_SIZES[0]+1; i++) avaliable[night][player][2] += actionsAvalaliable[i];
+            avaliable[night][player][2] = choices.TOTAL;
 
             //Find next player and next night
             int nextPlayerIndex = playerIndex+1;
@@ -207,9 +264,9 @@ static int assignPoisonForWorld(
 
             //See if deeper level inference leads to a good world
             int result = assignRoleForWorld(
-                possibleWorldKB, possibleWorldRevertKB, 
+                possibleWorldKB, 
                 determinedInNWorlds, 
-                rs, 
+                rs, rng, 
                 avaliable, 
                 nextNight, nextPlayerIndex, 
                 failures, 
@@ -217,25 +274,25 @@ static int assignPoisonForWorld(
                 isroleIndexes, notroleIndexes, 
                 poisonedIndexes, notPoisonedIndexes,
                 isPoisonedIndexes, isNotPoisonedIndexes,
-                killedIndexes, notKilledIndexes
+                killedIndexes, notKilledIndexes,
+                myGeneration, worldGeneration
             );
             if (result == 1) return 1;
             if (*failures > MAX_FALIURES) return -1; 
         }
 
         //If failed to find a world try a different role
-        actionsAvalaliable[playerToActionID] = 0; //Mark this role as unavaliable
-        avaliableActions--; //One less avaliable role now
-        copyTo(possibleWorldKB, myLayerRevertKB); //Revert to before inference
+        setRandChoiceWeight(&choices, playerToActionID, 0); //Mark this role as unavaliable
+        undoTrail(possibleWorldKB, trailMark); //Revert to before inference
     }
     //Failed to find anything
     return -1;
 }
 
 static int assignKillForWorld(
-    KnowledgeBase* possibleWorldKB, KnowledgeBase**** possibleWorldRevertKB, 
+    KnowledgeBase* possibleWorldKB, 
     ProbKnowledgeBase* determinedInNWorlds, 
-    RuleSet* rs, 
+    RuleSet* rs, RandState* rng, 
     int avaliable[5][MAX_SET_ELEMENTS][3], 
     int night, int playerIndex, 
     int *failures, 
@@ -243,39 +300,44 @@ static int assignKillForWorld(
     int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], 
     int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
     int isPoisonedIndexes[NUM_DAYS], int isNotPoisonedIndexes[NUM_DAYS], 
-    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS]
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
+    int myGeneration, atomic_int* worldGeneration
 )
 {
     //Choose player from random permutation to remove certain biases in allocation
     int player = permute[playerIndex];
 
-    KnowledgeBase* myLayerRevertKB = possibleWorldRevertKB[night][player][1];
-
-    int avaliableActions = 0;
     int actionsAvalaliable[NUM_BOTCT_ROLES];
 
     //You can always pick the "do nothing" action
     actionsAvalaliable[0] = 1;
-    avaliableActions++;
     for (int playerToAction = 0; playerToAction < possibleWorldKB->SET_SIZES[0]; playerToAction++)
     {
         int notKilledPlayers = isKnown(possibleWorldKB, 0, player, notKilledIndexes[night][playerToAction]);
 
         int roleAvaliable = notKilledPlayers ? 0 : 1;
         actionsAvalaliable[playerToAction+1] = roleAvaliable;
-        avaliableActions += roleAvaliable;
     }
+    RandChoices choices;
+    initRandChoices(&choices, actionsAvalaliable, possibleWorldKB->SET_SIZES[0]+1);
 
-    copyTo(myLayerRevertKB, possibleWorldKB); //copy to backup to revert later
+    int trailMark = getTrailMark(possibleWorldKB); //mark the trail to revert later
 
-    while (avaliableActions > 0)
+    while (choices.TOTAL > 0)
     {
-        int playerToActionID = getRandIntNotIn(actionsAvalaliable, avaliableActions);
+        //The knowledge base changed so this world is stale, stop searching
+        if (isStaleGeneration(myGeneration, worldGeneration)) return -1;
+
+        int playerToActionID = getRandChoice(rng, &choices);
+
+        //Track what is assumed so only rules watching it need checking
+        long changedWords[NUM_SETS] = {0};
 
         //Assume true
         if (playerToActionID != 0)
         {
             addKnowledge(possibleWorldKB, 0, player, killedIndexes[night][playerToActionID-1]);
+            markFunctionChanged(changedWords, 0, killedIndexes[night][playerToActionID-1]);
         }
         if (playerIndex+1 >= possibleWorldKB->SET_SIZES[0])
         {
@@ -288,6 +350,7 @@ static int assignKillForWorld(
                     if (killedPlayers == 0)
                     {
                         addKnowledge(possibleWorldKB, 0, playerID, notKilledIndexes[night][killedPlayerID]);
+                        markFunctionChanged(changedWords, 0, notKilledIndexes[night][killedPlayerID]);
                     }
                     else
                     {
@@ -304,7 +367,7 @@ static int assignKillForWorld(
             
 
         //Infer knowledge (to see if a contradiction arises)
-        if (inferImplicitFacts(possibleWorldKB, rs, NUM_SOLVE_STEPS, 0))
+        if (inferImplicitFactsIncremental(possibleWorldKB, rs, changedWords, NUM_SOLVE_STEPS, 0))
         { //If contradiction found by only adding "function" to assumptions we know NOT function is true 
             *failures = *failures+1;
             if (*failures > MAX_FALIURES) return -1;
@@ -313,10 +376,7 @@ static int assignKillForWorld(
         { //If I found a role to assign, try deeper layers
             //Find out how many roles are avaliable 
             //used for computing weights basic on non uniform probabilities later
-            avaliable[night][player][1] = 0;
-
-            //Swapped out for faster code;
-            for (int i = 0; i < possibleWorldKB->SET_SIZES[0]+1; i++) avaliable[night][player][1] += actionsAvalaliable[i];
+            avaliable[night][player][1] = choices.TOTAL;
 
             //Find next player and next night
             /*
@@ -333,9 +393,9 @@ static int assignKillForWorld(
 
             //See if deeper level inference leads to a good world
             int result = assignPoisonForWorld(
-                possibleWorldKB, possibleWorldRevertKB, 
+                possibleWorldKB, 
                 determinedInNWorlds, 
-                rs, 
+                rs, rng, 
                 avaliable, 
                 night, playerIndex, 
                 failures, 
@@ -343,25 +403,25 @@ static int assignKillForWorld(
                 isroleIndexes, notroleIndexes, 
                 poisonedIndexes, notPoisonedIndexes,
                 isPoisonedIndexes, isNotPoisonedIndexes,
-                killedIndexes, notKilledIndexes
+                killedIndexes, notKilledIndexes,
+                myGeneration, worldGeneration
             );
             if (result == 1) return 1;
             if (*failures > MAX_FALIURES) return -1; 
         }
 
         //If failed to find a world try a different role
-        actionsAvalaliable[playerToActionID] = 0; //Mark this role as unavaliable
-        avaliableActions--; //One less avaliable role now
-        copyTo(possibleWorldKB, myLayerRevertKB); //Revert to before inference
+        setRandChoiceWeight(&choices, playerToActionID, 0); //Mark this role as unavaliable
+        undoTrail(possibleWorldKB, trailMark); //Revert to before inference
     }
     //Failed to find anything
     return -1;
 }
 
 static int assignRoleForWorld(
-    KnowledgeBase* possibleWorldKB, KnowledgeBase**** possibleWorldRevertKB, 
+    KnowledgeBase* possibleWorldKB, 
     ProbKnowledgeBase* determinedInNWorlds, 
-    RuleSet* rs, 
+    RuleSet* rs, RandState* rng, 
     int avaliable[5][MAX_SET_ELEMENTS][3], 
     int night, int playerIndex, 
     int *failures, 
@@ -369,16 +429,14 @@ static int assignRoleForWorld(
     int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], 
     int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
     int isPoisonedIndexes[NUM_DAYS], int isNotPoisonedIndexes[NUM_DAYS], 
-    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS]
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
+    int myGeneration, atomic_int* worldGeneration
 )
 {
     //printf("TEST player %d, night %d\n", playerIndex, night);
     //Choose player from random permutation to remove certain biases in allocation
     int player = permute[playerIndex];
 
-    KnowledgeBase* myLayerRevertKB = possibleWorldRevertKB[night][player][0];
-
-    int avaliableRoles = 0;
     int roleAvalaliable[NUM_BOTCT_ROLES];
     for (int roleID = 0; roleID < NUM_BOTCT_ROLES; roleID++)
     {
@@ -386,20 +444,28 @@ static int assignRoleForWorld(
 
         int roleAvaliable = isNotRole ? 0 : 1;
         roleAvalaliable[roleID] = roleAvaliable;
-        avaliableRoles += roleAvaliable;
     }
+    RandChoices choices;
+    initRandChoices(&choices, roleAvalaliable, NUM_BOTCT_ROLES);
 
-    copyTo(myLayerRevertKB, possibleWorldKB); //copy to backup to revert later
+    int trailMark = getTrailMark(possibleWorldKB); //mark the trail to revert later
 
-    while (avaliableRoles > 0)
+    while (choices.TOTAL > 0)
     {
-        int selectedRoleID = getRandIntNotIn(roleAvalaliable, avaliableRoles);
+        //The knowledge base changed so this world is stale, stop searching
+        if (isStaleGeneration(myGeneration, worldGeneration)) return -1;
+
+        int selectedRoleID = getRandChoice(rng, &choices);
 
         //Assume true
         addKnowledge(possibleWorldKB, 0, player, isroleIndexes[night][selectedRoleID]);
 
+        //Track what is assumed so only rules watching it need checking
+        long changedWords[NUM_SETS] = {0};
+        markFunctionChanged(changedWords, 0, isroleIndexes[night][selectedRoleID]);
+
         //Infer knowledge (to see if a contradiction arises)
-        if (inferImplicitFacts(possibleWorldKB, rs, NUM_SOLVE_STEPS, 0))
+        if (inferImplicitFactsIncremental(possibleWorldKB, rs, changedWords, NUM_SOLVE_STEPS, 0))
         { //If contradiction found by only adding "function" to assumptions we know NOT function is true 
             *failures = *failures+1;
             if (*failures > MAX_FALIURES) return -1;
@@ -408,10 +474,7 @@ static int assignRoleForWorld(
         { //If I found a role to assign, try deeper layers
             //Find out how many roles are avaliable 
             //used for computing weights basic on non uniform probabilities later
-            avaliable[night][player][0] = 0;
-
-            //Swapped out for faster code;
-            for (int i = 0; i < NUM_BOTCT_ROLES; i++) avaliable[night][player][0] += roleAvalaliable[i];
+            avaliable[night][player][0] = choices.TOTAL;
 
             //Find next player and next night
             /*
@@ -428,9 +491,9 @@ static int assignRoleForWorld(
 
             //See if deeper level inference leads to a good world
             int result = assignKillForWorld(
-                possibleWorldKB, possibleWorldRevertKB, 
+                possibleWorldKB, 
                 determinedInNWorlds, 
-                rs, 
+                rs, rng, 
                 avaliable, 
                 night, playerIndex, 
                 failures, 
@@ -438,16 +501,16 @@ static int assignRoleForWorld(
                 isroleIndexes, notroleIndexes, 
                 poisonedIndexes, notPoisonedIndexes,
                 isPoisonedIndexes, isNotPoisonedIndexes,
-                killedIndexes, notKilledIndexes
+                killedIndexes, notKilledIndexes,
+                myGeneration, worldGeneration
             );
             if (result == 1) return 1;
             if (*failures > MAX_FALIURES) return -1; 
         }
 
         //If failed to find a world try a different role
-        roleAvalaliable[selectedRoleID] = 0; //Mark this role as unavaliable
-        avaliableRoles--; //One less avaliable role now
-        copyTo(possibleWorldKB, myLayerRevertKB); //Revert to before inference
+        setRandChoiceWeight(&choices, selectedRoleID, 0); //Mark this role as unavaliable
+        undoTrail(possibleWorldKB, trailMark); //Revert to before inference
     }
     //Failed to find anything
     return -1;
@@ -458,21 +521,24 @@ static int assignRoleForWorld(
  * if the world is without any detectable contradictin add to determinedInNWorlds
  * 
  * @possibleWorldKB the knowledge base to build the world in
- * @possibleWorldRevertKB a working memory space to store backups for backtracking
  * @determinedInNWorlds the tally to add the score to if the world works
  * @rs the ruleset
+ * @rng the random number generator of this thread
+ * @myGeneration the world generation this world is built for
+ * @worldGeneration the current world generation, the search is abandoned as soon as it moves on
+ * @verbose if 1 print each world found
 */
 static void buildWorld(
-    KnowledgeBase* possibleWorldKB, KnowledgeBase**** possibleWorldRevertKB, 
+    KnowledgeBase* possibleWorldKB, 
     ProbKnowledgeBase* determinedInNWorlds, 
-    CachedKnowledgeBases* POSSIBLE_WORLDS_FOR_PROB, int (*POSSIBLE_WORLD_GENERATED)[MAX_SET_ELEMENTS][NUM_BOTCT_ROLES][NUM_DAYS],
-    RuleSet* rs, 
-    int myGeneration, int *worldGeneration,
+    CachedKnowledgeBases* POSSIBLE_WORLDS_FOR_PROB,
+    RuleSet* rs, RandState* rng, 
+    int myGeneration, atomic_int* worldGeneration,
     int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], 
     int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
     int isPoisonedIndexes[NUM_DAYS], int isNotPoisonedIndexes[NUM_DAYS],
-    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS]
-
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
+    int verbose
 )
 {
 
@@ -484,11 +550,13 @@ static void buildWorld(
     {
         temp[i] = 1;
     }
+    RandChoices unpicked;
+    initRandChoices(&unpicked, temp, possibleWorldKB->SET_SIZES[0]);
     for (int i = 0; i < possibleWorldKB->SET_SIZES[0]; i++)
     {
-        int rand = getRandIntNotIn(temp, possibleWorldKB->SET_SIZES[0]-i);
+        int rand = getRandChoice(rng, &unpicked);
         permute[i] = rand;
-        temp[rand] = 0;
+        setRandChoiceWeight(&unpicked, rand, 0);
     }
     
 
@@ -501,11 +569,14 @@ static void buildWorld(
      * ELSE: continue until all player are assigned roles
      * once/if every player is assigned roles add this to the tally
     */
+    //Layers only check the rules watching what they assume, so start from a fully infered world
+    if (inferImplicitFacts(possibleWorldKB, rs, NUM_SOLVE_STEPS, 0)) return;
+
     int faliures = 0;
     int result = assignRoleForWorld(
-        possibleWorldKB, possibleWorldRevertKB, 
+        possibleWorldKB, 
         determinedInNWorlds, 
-        rs, 
+        rs, rng, 
         avaliable, 
         0, 0, //night, player index 
         &faliures, 
@@ -513,11 +584,12 @@ static void buildWorld(
         isroleIndexes, notroleIndexes, 
         poisonedIndexes, notPoisonedIndexes,
         isPoisonedIndexes, isNotPoisonedIndexes,
-        killedIndexes, notKilledIndexes
+        killedIndexes, notKilledIndexes,
+        myGeneration, worldGeneration
     );
     if (result == -1) 
     {
-        printf("WORLD HAD TOO MANY CONRADICTIONS\n");
+        if (verbose && !isStaleGeneration(myGeneration, worldGeneration)) printf("WORLD HAD TOO MANY CONRADICTIONS\n");
         return; //If no valid world was found
     }
     //printf("ADD WEIGHT\n");
@@ -536,30 +608,15 @@ static void buildWorld(
         }
     }
     //printf("\n");
-    printf("FOUND WORLD (Scaling Weight=%f)!\n", weight);
+    if (verbose) printf("FOUND WORLD (Scaling Weight=%f)!\n", weight);
     //Add weighted tally
     addKBtoProbTally(possibleWorldKB, determinedInNWorlds, weight);
 
     pthread_mutex_lock(&cacheworldlock);   // Lock before accessing shared data
         // Critical section 
-        if (myGeneration == *worldGeneration)
+        if (!isStaleGeneration(myGeneration, worldGeneration))
         {
-            int location = addKBToCache(POSSIBLE_WORLDS_FOR_PROB, possibleWorldKB, weight);
-        
-            for (int night = 0; night < NUM_DAYS; night++)
-            {
-                for (int player = 0; player < possibleWorldKB->SET_SIZES[0]; player++)
-                {
-                    int role = 0;
-                    while (role < NUM_BOTCT_ROLES)
-                    {
-                        int isRole = isKnown(possibleWorldKB, 0, player, isroleIndexes[night][role]);
-                        if (isRole) break;
-                        role++;
-                    }
-                    if ((*POSSIBLE_WORLD_GENERATED)[player][role][night] == -1) (*POSSIBLE_WORLD_GENERATED)[player][role][night] = location;
-                }
-            }
+            addKBToCache(POSSIBLE_WORLDS_FOR_PROB, possibleWorldKB, weight);
         }
     pthread_mutex_unlock(&cacheworldlock); // Unlock after done
     
@@ -568,33 +625,24 @@ static void buildWorld(
     
 }
 
-void* getProbApproxContinuous(void* void_arg)
+/**
+ * getWorldFunctionIDs() - look up the functions a world assigns (roles, kills and poisonings) for every night
+ * 
+ * @kb the knowledge base
+ * @isroleIndexes OUTPUTS is_<ROLE>_[NIGHTn] of each night and role, notroleIndexes is_NOT_<ROLE>_[NIGHTn]
+ * @poisonedIndexes OUTPUTS POISONED_<player>_[NIGHTn] of each night and player, notPoisonedIndexes NOT_POISONED_<player>_[NIGHTn]
+ * @isPoisonedIndexes OUTPUTS is_POISONED_[NIGHTn] of each night, isNotPoisonedIndexes is_NOT_POISONED_[NIGHTn]
+ * @killedIndexes OUTPUTS KILLED_<player>_[NIGHTn] of each night and player, notKilledIndexes NOT_KILLED_<player>_[NIGHTn]
+*/
+static void getWorldFunctionIDs(
+    KnowledgeBase* kb,
+    int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES], 
+    int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS],
+    int isPoisonedIndexes[NUM_DAYS], int isNotPoisonedIndexes[NUM_DAYS],
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS]
+)
 {
-    //Arguments
-    struct getProbApproxArgs *args = (struct getProbApproxArgs*) void_arg; //Get arguments by casting
-    //Upack arguments
-    KnowledgeBase* kb = args->kb;
-    KnowledgeBase* possibleWorldKB = args->possibleWorldKB;
-    KnowledgeBase**** possibleWorldRevertKB = args->possibleWorldRevertKB;
-    ProbKnowledgeBase* determinedInNWorlds = args->determinedInNWorlds;
-    ProbKnowledgeBase* worldTally = args->worldTally;
-    CachedKnowledgeBases* POSSIBLE_WORLDS_FOR_PROB = args->POSSIBLE_WORLDS_FOR_PROB;
-    int (*POSSIBLE_WORLD_GENERATED)[MAX_SET_ELEMENTS][NUM_BOTCT_ROLES][NUM_DAYS] = args->POSSIBLE_WORLD_GENERATED;
-    RuleSet* rs = args->rs;
-    int* worldGeneration = args->worldGeneration;
-    bool* reRenderCall = args->reRenderCall;
-    int numIterations = args->numIterations;
-
-    //Cache role data locations for fast lookup
     char buff[STRING_BUFF_SIZE];
-    int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES];
-    int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES];
-    int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
-    int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
-    int isPoisonedIndexes[NUM_DAYS];
-    int isNotPoisonedIndexes[NUM_DAYS];
-    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
-    int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
     for (int night = 0; night < NUM_DAYS; night++)
     {
         for (int role = 0; role < NUM_BOTCT_ROLES; role++)
@@ -630,69 +678,887 @@ void* getProbApproxContinuous(void* void_arg)
             notPoisonedIndexes[night][playerID] = getSetFunctionIDWithName(kb, 0, buff, 1);
         }
     }
+}
+
+#define SAT_MAX_CONFLICTS 100000 //Conflicts before a SAT search for one world gives up
+#define EXACT_MAX_RETRIES 10 //Searches in a row that give up before getProbExact() stops counting
+
+/**
+ * initWorldSatSolver() - compile a knowledge base into a solver that builds the same worlds as buildWorld()
+ * on top of the rules each player has one role, kills at most one player and poisons at most one player each night
+ * and a player nobody poisons is not poisoned
+ * 
+ * @kb the knowledge base with every fact infered
+ * @rs the ruleset
+ * 
+ * @return the solver
+*/
+static SatSolver* initWorldSatSolver(
+    KnowledgeBase* kb, RuleSet* rs,
+    int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES],
+    int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS], int isNotPoisonedIndexes[NUM_DAYS],
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS]
+)
+{
+    SatSolver* sat = initSatSolver(rs, kb);
+    int numPlayers = kb->SET_SIZES[0];
+    int literals[NUM_BOTCT_ROLES+1];
+    for (int night = 0; night < NUM_DAYS; night++)
+    {
+        for (int player = 0; player < numPlayers; player++)
+        {
+            int numLiterals = 0;
+            for (int roleID = 0; roleID < NUM_BOTCT_ROLES; roleID++)
+            {
+                literals[numLiterals] = FUNCTION_LITERAL(0, player, isroleIndexes[night][roleID]);
+                numLiterals++;
+            }
+            addSatCount(sat, NULL, 0, literals, numLiterals, 1, 1);
+
+            for (int target = 0; target < numPlayers; target++)
+            {
+                literals[target] = FUNCTION_LITERAL(0, player, killedIndexes[night][target]);
+            }
+            addSatCount(sat, NULL, 0, literals, numPlayers, 0, 1);
+
+            for (int target = 0; target < numPlayers; target++)
+            {
+                literals[target] = FUNCTION_LITERAL(0, player, poisonedIndexes[night][target]);
+            }
+            addSatCount(sat, NULL, 0, literals, numPlayers, 0, 1);
+        }
+
+        for (int target = 0; target < numPlayers; target++)
+        {
+            for (int player = 0; player < numPlayers; player++)
+            {
+                literals[player] = FUNCTION_LITERAL(0, player, poisonedIndexes[night][target]);
+            }
+            literals[numPlayers] = FUNCTION_LITERAL(0, target, isNotPoisonedIndexes[night]);
+            addSatClause(sat, literals, numPlayers+1);
+        }
+    }
+    return sat;
+}
 
-    int myGeneration = *worldGeneration;
+/**
+ * buildWorldSat() - build a random world with the SAT solver and add it to determinedInNWorlds,
+ * the search doesn't pick worlds uniformly or with buildWorld()'s weights so the tally is a set
+ * of witness worlds (which roles are possible), not an estimate of the probabilities
+ * 
+ * @possibleWorldKB a copy of the knowledge base to write the world to
+ * @determinedInNWorlds the tally to add the world to
+ * @sat the solver for this generation, NULL if the knowledge base has a contradiction
+ * @rng the random number generator of this thread
+ * @myGeneration the world generation this world is built for
+ * @worldGeneration the current world generation
+ * @verbose if 1 print each world found
+*/
+static void buildWorldSat(
+    KnowledgeBase* possibleWorldKB, 
+    ProbKnowledgeBase* determinedInNWorlds, 
+    CachedKnowledgeBases* POSSIBLE_WORLDS_FOR_PROB,
+    SatSolver* sat, RandState* rng, 
+    int myGeneration, atomic_int* worldGeneration,
+    int verbose
+)
+{
+    int result = sat != NULL ? solveSat(sat, rng, SAT_MAX_CONFLICTS) : 0;
+    if (result != 1)
+    {
+        if (verbose && result == 0) printf("NO WORLD EXISTS\n");
+        if (verbose && result == -1) printf("WORLD HAD TOO MANY CONRADICTIONS\n");
+        return;
+    }
+    writeSatModel(sat, possibleWorldKB);
+
+    double weight = 1.0; //No weighting is known for the solver's choices, each witness counts once
+    if (verbose) printf("FOUND WORLD (Scaling Weight=%f)!\n", weight);
+    addKBtoProbTally(possibleWorldKB, determinedInNWorlds, weight);
+
+    pthread_mutex_lock(&cacheworldlock);
+        if (!isStaleGeneration(myGeneration, worldGeneration))
+        {
+            addKBToCache(POSSIBLE_WORLDS_FOR_PROB, possibleWorldKB, weight);
+        }
+    pthread_mutex_unlock(&cacheworldlock);
+}
+
+/**
+ * addNightActionBlock() - add the literals blocking one player's kills or poisonings on a night
+ * 
+ * @world the world
+ * @player the playerID/index
+ * @actionIndexes the action's function of each target
+ * @literals OUTPUTS the blocking clause
+ * @numLiterals the length of the clause so far
+ * 
+ * @return the new length of the clause
+*/
+static int addNightActionBlock(KnowledgeBase* world, int player, int actionIndexes[MAX_SET_ELEMENTS], int* literals, int numLiterals)
+{
+    int numPlayers = world->SET_SIZES[0];
+    int acted = 0;
+    for (int target = 0; target < numPlayers; target++)
+    {
+        if (isKnown(world, 0, player, actionIndexes[target]))
+        { //Some other target
+            literals[numLiterals] = FUNCTION_LITERAL(0, player, actionIndexes[target]) ^ 1;
+            numLiterals++;
+            acted = 1;
+        }
+    }
+    if (acted) return numLiterals;
+
+    //Did nothing, any target is different
+    for (int target = 0; target < numPlayers; target++)
+    {
+        literals[numLiterals] = FUNCTION_LITERAL(0, player, actionIndexes[target]);
+        numLiterals++;
+    }
+    return numLiterals;
+}
+
+/**
+ * getProbExact() - tally every combination of night 0 roles, kills and poisonings without a contradiction once,
+ * the combinations the backtracking sampler weights its worlds to count, so the night 0 role probabilities are exact
+ * each combination is tallied as the one complete world the SAT solver found for it,
+ * so the functions of later nights are NOT exact and only show what one world per combination holds
+ * 
+ * @kb the knowledge base
+ * @rs the ruleset
+ * @tally OUTPUTS the tally
+ * @maxWorlds the most combinations to tally, 0 for no limit
+ * @timeBudget the most seconds to spend, 0 for no limit
+ * 
+ * @return 1 if every combination was tallied, 0 if the budget ran out (or the searches kept giving up) first
+*/
+int getProbExact(KnowledgeBase* kb, RuleSet* rs, ProbKnowledgeBase* tally, long maxWorlds, double timeBudget)
+{
+    int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES];
+    int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES];
+    int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    int isPoisonedIndexes[NUM_DAYS];
+    int isNotPoisonedIndexes[NUM_DAYS];
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    getWorldFunctionIDs(
+        kb, 
+        isroleIndexes, notroleIndexes, 
+        poisonedIndexes, notPoisonedIndexes, 
+        isPoisonedIndexes, isNotPoisonedIndexes,
+        killedIndexes, notKilledIndexes
+    );
+
+    resetProbKnowledgeBase(tally);
+    KnowledgeBase* world = initKBFromTemplate(kb);
+    if (inferImplicitFacts(world, rs, NUM_SOLVE_STEPS, 0))
+    { //No worlds at all
+        free(world);
+        return 1;
+    }
+    SatSolver* sat = initWorldSatSolver(world, rs, isroleIndexes, poisonedIndexes, isNotPoisonedIndexes, killedIndexes);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double start = now.tv_sec + now.tv_nsec / 1e9;
+
+    int numPlayers = kb->SET_SIZES[0];
+    int blocking[numPlayers * (2*numPlayers + 1)];
+    int exact = 0;
+    int retries = 0;
+    while (1)
+    {
+        if (maxWorlds > 0 && tally->numWorlds >= maxWorlds) break;
+        if (timeBudget > 0)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if (now.tv_sec + now.tv_nsec / 1e9 - start >= timeBudget) break;
+        }
+
+        //Learnt clauses are kept between searches so each search reuses what the last ones found
+        int result = solveSat(sat, NULL, SAT_MAX_CONFLICTS);
+        if (result == -1)
+        { //Without a budget the search could give up forever
+            retries++;
+            if (retries >= EXACT_MAX_RETRIES) break;
+            continue;
+        }
+        retries = 0;
+        if (result == 0)
+        { //Every combination has been found
+            exact = 1;
+            break;
+        }
+
+        copyTo(world, kb);
+        writeSatModel(sat, world);
+        addKBtoProbTally(world, tally, 1.0);
+
+        //Block this combination of night 0 roles, kills and poisonings so the next search finds a new one
+        int numBlocking = 0;
+        for (int player = 0; player < numPlayers; player++)
+        {
+            for (int roleID = 0; roleID < NUM_BOTCT_ROLES; roleID++)
+            {
+                if (isKnown(world, 0, player, isroleIndexes[0][roleID]))
+                {
+                    blocking[numBlocking] = FUNCTION_LITERAL(0, player, isroleIndexes[0][roleID]) ^ 1;
+                    numBlocking++;
+                }
+            }
+            numBlocking = addNightActionBlock(world, player, killedIndexes[0], blocking, numBlocking);
+            numBlocking = addNightActionBlock(world, player, poisonedIndexes[0], blocking, numBlocking);
+        }
+        addSatClause(sat, blocking, numBlocking);
+    }
+
+    freeSatSolver(sat);
+    free(world);
+    return exact;
+}
+
+/**
+ * initPublishedTally() - allocate an empty published tally for a sampler thread
+ * 
+ * @kb - knowledge base the tallies are sized for
+ * 
+ * Return: pointer to the published tally
+*/
+PublishedTally* initPublishedTally(KnowledgeBase* kb)
+{
+    PublishedTally* published = (PublishedTally*) malloc(sizeof(PublishedTally));
+    if (published == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    atomic_init(&published->SEQUENCE, 0);
+    published->GENERATION = -1;
+    published->TALLY = initProbKB(kb);
+    published->SNAPSHOT = initProbKB(kb);
+    return published;
+}
+
+/**
+ * publishTally() - add a batch of worlds to a thread's published tally
+ * only ever called by the thread that owns the published tally
+ * 
+ * @published - the thread's published tally
+ * @batch - worlds found since the last publish
+ * @generation - world generation the batch was sampled in
+*/
+void publishTally(PublishedTally* published, ProbKnowledgeBase* batch, int generation)
+{
+    unsigned int sequence = atomic_load_explicit(&published->SEQUENCE, memory_order_relaxed);
+    atomic_store_explicit(&published->SEQUENCE, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release); //Odd sequence is visible before any of the writes
+
+    if (published->GENERATION != generation)
+    {
+        resetProbKnowledgeBase(published->TALLY);
+        published->GENERATION = generation;
+    }
+    mergeProbKnowledge(published->TALLY, batch);
+
+    atomic_store_explicit(&published->SEQUENCE, sequence + 2, memory_order_release);
+}
+
+/**
+ * readPublishedTally() - copy a consistent snapshot of a published tally into its SNAPSHOT
+ * there is one SNAPSHOT per published tally so only one thread may ever read it (the one summing the tallies)
+ * 
+ * @published - the published tally to read
+ * 
+ * Return: the generation the snapshot was sampled in
+*/
+static int readPublishedTally(PublishedTally* published)
+{
+    ProbKnowledgeBase* tally = published->TALLY;
+    ProbKnowledgeBase* snapshot = published->SNAPSHOT;
+    while (1)
+    {
+        unsigned int before = atomic_load_explicit(&published->SEQUENCE, memory_order_acquire);
+        if (before & 1)
+        { //Writer is mid publish, let it run instead of spinning (it may share our CPU)
+            sched_yield();
+            continue;
+        }
+
+        int generation = published->GENERATION;
+        memcpy(snapshot->VALUES, tally->VALUES, sizeof(ProbTallyValue)*tally->SIZE);
+        snapshot->tally = tally->tally;
+        snapshot->numWorlds = tally->numWorlds;
+
+        atomic_thread_fence(memory_order_acquire); //Copies finish before the sequence is checked again
+        if (atomic_load_explicit(&published->SEQUENCE, memory_order_relaxed) == before) return generation;
+        sched_yield();
+    }
+}
+
+/**
+ * sumPublishedTallies() - sum the published tallies of the current generation without locking the samplers
+ * only one thread may call this for a set of published tallies (it reads into their SNAPSHOT)
+ * 
+ * @total - tally to write the sum into
+ * @base - tally the samplers are adding to (e.g. the cached worlds), or NULL
+ * @published - the published tallies of each thread
+ * @numPublished - number of published tallies
+ * @generation - current world generation, tallies from older generations are skipped
+*/
+void sumPublishedTallies(ProbKnowledgeBase* total, ProbKnowledgeBase* base, PublishedTally** published, int numPublished, int generation)
+{
+    resetProbKnowledgeBase(total);
+    if (base != NULL) mergeProbKnowledge(total, base);
+    for (int i = 0; i < numPublished; i++)
+    {
+        if (readPublishedTally(published[i]) == generation)
+        {
+            mergeProbKnowledge(total, published[i]->SNAPSHOT);
+        }
+    }
+}
+
+/**
+ * initSamplerPool() - allocate a pool of sampler threads (not started)
+ * 
+ * @numThreads number of threads, 0 to use one per hardware thread
+ * 
+ * @return pointer to the pool
+*/
+SamplerPool* initSamplerPool(int numThreads)
+{
+    if (numThreads <= 0) numThreads = getNumHardwareThreads();
+
+    SamplerPool* pool = (SamplerPool*) malloc(sizeof(SamplerPool));
+    if (pool == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+    pool->NUM_THREADS = numThreads;
+    pool->THREADS = (pthread_t*) malloc(sizeof(pthread_t)*numThreads);
+    pool->ARGS = (struct getProbApproxArgs*) malloc(sizeof(struct getProbApproxArgs)*numThreads);
+    pool->PUBLISHED_TALLIES = (PublishedTally**) malloc(sizeof(PublishedTally*)*numThreads);
+    if (pool->THREADS == NULL || pool->ARGS == NULL || pool->PUBLISHED_TALLIES == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+
+    pthread_mutex_init(&pool->LOCK, NULL);
+    pthread_cond_init(&pool->WAKE, NULL);
+    pthread_cond_init(&pool->JOB_DONE, NULL);
+    atomic_init(&pool->PAUSED, 0);
+    atomic_init(&pool->HAS_JOB, 0);
+    pool->JOB = NULL;
+    return pool;
+}
+
+/**
+ * startSamplerPool() - start every thread in the pool sampling worlds
+ * 
+ * @pool the pool
+ * @args arguments shared by every thread, each thread gets its own working knowledge base,
+ * tallies and random stream (seed + thread index)
+*/
+void startSamplerPool(SamplerPool* pool, struct getProbApproxArgs* args)
+{
+    for (int i = 0; i < pool->NUM_THREADS; i++)
+    {
+        pool->PUBLISHED_TALLIES[i] = initPublishedTally(args->kb);
+
+        struct getProbApproxArgs* threadArgs = &pool->ARGS[i];
+        *threadArgs = *args;
+        threadArgs->possibleWorldKB = initKBFromTemplate(args->kb); //Working block of memory
+        threadArgs->determinedInNWorlds = initProbKB(args->kb); //The output tallies
+        threadArgs->publishedTally = pool->PUBLISHED_TALLIES[i];
+        threadArgs->seed = args->seed + i; //Different stream per thread
+        threadArgs->pool = pool;
+        threadArgs->worker = i;
+    }
+    for (int i = 0; i < pool->NUM_THREADS; i++)
+    {
+        pthread_create(&pool->THREADS[i], NULL, &getProbApproxContinuous, (void *) &pool->ARGS[i]);
+    }
+}
+
+/**
+ * pauseSamplerPool() - park the threads after their current batch of worlds
+ * 
+ * @pool the pool
+*/
+void pauseSamplerPool(SamplerPool* pool)
+{
+    pthread_mutex_lock(&pool->LOCK);
+        atomic_store(&pool->PAUSED, 1);
+    pthread_mutex_unlock(&pool->LOCK);
+}
+
+/**
+ * resumeSamplerPool() - wake parked threads to carry on sampling
+ * 
+ * @pool the pool
+*/
+void resumeSamplerPool(SamplerPool* pool)
+{
+    pthread_mutex_lock(&pool->LOCK);
+        atomic_store(&pool->PAUSED, 0);
+        pthread_cond_broadcast(&pool->WAKE);
+    pthread_mutex_unlock(&pool->LOCK);
+}
+
+/**
+ * claimPoolTask() - claim the next task of a job, stealing from other ranges once our own runs out
+ * 
+ * @job the job
+ * @range the range owned by the caller
+ * 
+ * @return the task, or -1 if every task has been claimed
+*/
+static int claimPoolTask(PoolJob* job, int range)
+{
+    for (int i = 0; i < job->NUM_RANGES; i++)
+    {
+        int victim = (range + i) % job->NUM_RANGES;
+        if (atomic_load_explicit(&job->NEXT[victim], memory_order_relaxed) >= job->END[victim]) continue;
+
+        int task = atomic_fetch_add_explicit(&job->NEXT[victim], 1, memory_order_relaxed);
+        if (task < job->END[victim]) return task;
+    }
+    return -1;
+}
+
+/**
+ * helpWithPoolJob() - run tasks of the pool's current job (if any) until none are left
+ * 
+ * @pool the pool
+ * @worker index of the calling thread
+*/
+static void helpWithPoolJob(SamplerPool* pool, int worker)
+{
+    pthread_mutex_lock(&pool->LOCK);
+        PoolJob* job = pool->JOB;
+        if (job != NULL) job->ACTIVE++;
+    pthread_mutex_unlock(&pool->LOCK);
+    if (job == NULL) return;
+
+    int task;
+    while ((task = claimPoolTask(job, worker)) != -1)
+    {
+        job->RUN(job->ARG, task, worker);
+    }
+
+    pthread_mutex_lock(&pool->LOCK);
+        job->ACTIVE--;
+        if (job->ACTIVE == 0) pthread_cond_broadcast(&pool->JOB_DONE);
+    pthread_mutex_unlock(&pool->LOCK);
+}
+
+/**
+ * runOnSamplerPool() - run a job on the calling thread and any pool threads between batches
+ * returns once every task has finished, only one job may run at a time
+ * 
+ * @pool the pool (NULL to run every task on the calling thread)
+ * @run the task function, worker is in 0..NUM_THREADS (the caller is NUM_THREADS)
+ * @arg passed to run
+ * @numTasks number of tasks
+*/
+void runOnSamplerPool(SamplerPool* pool, void (*run)(void* arg, int task, int worker), void* arg, int numTasks)
+{
+    if (pool == NULL)
+    {
+        for (int task = 0; task < numTasks; task++) run(arg, task, 0);
+        return;
+    }
+
+    //One range per thread and one for the caller
+    int numRanges = pool->NUM_THREADS + 1;
+    atomic_int next[numRanges];
+    int end[numRanges];
+    for (int i = 0; i < numRanges; i++)
+    {
+        atomic_init(&next[i], (int) ((long) numTasks * i / numRanges));
+        end[i] = (int) ((long) numTasks * (i+1) / numRanges);
+    }
+    PoolJob job = {run, arg, numRanges, next, end, 0};
+
+    pthread_mutex_lock(&pool->LOCK);
+        pool->JOB = &job;
+        atomic_store(&pool->HAS_JOB, 1);
+        pthread_cond_broadcast(&pool->WAKE); //Parked threads can help too
+    pthread_mutex_unlock(&pool->LOCK);
+
+    //Threads busy with a batch join late, the caller steals whatever they haven't claimed
+    helpWithPoolJob(pool, pool->NUM_THREADS);
+
+    pthread_mutex_lock(&pool->LOCK);
+        pool->JOB = NULL;
+        atomic_store(&pool->HAS_JOB, 0);
+        while (job.ACTIVE > 0) pthread_cond_wait(&pool->JOB_DONE, &pool->LOCK);
+    pthread_mutex_unlock(&pool->LOCK);
+}
+
+/**
+ * checkInToSamplerPool() - called by pool threads between batches to help with jobs and park while paused
+ * 
+ * @pool the pool
+ * @worker index of the calling thread
+*/
+void checkInToSamplerPool(SamplerPool* pool, int worker)
+{
+    while (1)
+    {
+        if (atomic_load_explicit(&pool->HAS_JOB, memory_order_relaxed)) helpWithPoolJob(pool, worker);
+        if (atomic_load_explicit(&pool->PAUSED, memory_order_relaxed) == 0) return;
+
+        pthread_mutex_lock(&pool->LOCK);
+            while (atomic_load(&pool->PAUSED) && pool->JOB == NULL) pthread_cond_wait(&pool->WAKE, &pool->LOCK);
+        pthread_mutex_unlock(&pool->LOCK);
+    }
+}
+
+void* getProbApproxContinuous(void* void_arg)
+{
+    //Arguments
+    struct getProbApproxArgs *args = (struct getProbApproxArgs*) void_arg; //Get arguments by casting
+    //Upack arguments
+    KnowledgeBase* kb = args->kb;
+    KnowledgeBase* possibleWorldKB = args->possibleWorldKB;
+    ProbKnowledgeBase* determinedInNWorlds = args->determinedInNWorlds;
+    PublishedTally* publishedTally = args->publishedTally;
+    CachedKnowledgeBases* POSSIBLE_WORLDS_FOR_PROB = args->POSSIBLE_WORLDS_FOR_PROB;
+    VersionedRuleSet* ruleSets = args->ruleSets;
+    atomic_int* worldGeneration = args->worldGeneration;
+    SamplerPool* pool = args->pool;
+
+    //Each thread has its own generator so threads don't contend on or share random state
+    RandState rng;
+    initRandState(&rng, args->seed);
+    bool* reRenderCall = args->reRenderCall;
+    int numIterations = args->numIterations;
+
+    //Cache role data locations for fast lookup
+    int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES];
+    int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES];
+    int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    int isPoisonedIndexes[NUM_DAYS];
+    int isNotPoisonedIndexes[NUM_DAYS];
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    getWorldFunctionIDs(
+        kb, 
+        isroleIndexes, notroleIndexes, 
+        poisonedIndexes, notPoisonedIndexes, 
+        isPoisonedIndexes, isNotPoisonedIndexes,
+        killedIndexes, notKilledIndexes
+    );
+
+    //Backtracking undoes changes logged to the trail instead of copying whole knowledge bases
+    if (possibleWorldKB->TRAIL == NULL) possibleWorldKB->TRAIL = initKBTrail();
+
+    //Rules are published before the generation is bumped, so pinning after reading it never gets older rules
+    int myGeneration = atomic_load(worldGeneration);
+    RuleSet* rs = pinRuleSet(ruleSets, args->worker);
+
+    //The SAT backend compiles each generation once and then only searches
+    SatSolver* sat = NULL;
+    int satGeneration = -1;
     
     //Loop forever adding 
     while (1)
     {
+        //Between batches help with jobs lent to the pool, or park
+        if (pool != NULL) checkInToSamplerPool(pool, args->worker);
+        if (isStaleGeneration(myGeneration, worldGeneration))
+        { //The knowledge base changed while we were parked
+            myGeneration = atomic_load(worldGeneration);
+            rs = pinRuleSet(ruleSets, args->worker);
+        }
+
+        if (args->satBackend && satGeneration != myGeneration)
+        {
+            if (sat != NULL) freeSatSolver(sat);
+            sat = NULL;
+            copyTo(possibleWorldKB, kb);
+            possibleWorldKB->TRAIL->LENGTH = 0;
+            if (!inferImplicitFacts(possibleWorldKB, rs, NUM_SOLVE_STEPS, 0))
+            {
+                sat = initWorldSatSolver(possibleWorldKB, rs, isroleIndexes, poisonedIndexes, isNotPoisonedIndexes, killedIndexes);
+            }
+            satGeneration = myGeneration;
+        }
+
         resetProbKnowledgeBase(determinedInNWorlds);
         for (int i = 0; i < numIterations; i++)
         {
-            if (myGeneration != *worldGeneration) break;
+            if (isStaleGeneration(myGeneration, worldGeneration)) break;
             copyTo(possibleWorldKB, kb);
+            possibleWorldKB->TRAIL->LENGTH = 0; //Nothing to undo in a fresh copy
+            if (args->satBackend)
+            {
+                buildWorldSat(
+                    possibleWorldKB, 
+                    determinedInNWorlds, 
+                    POSSIBLE_WORLDS_FOR_PROB, 
+                    sat, &rng, 
+                    myGeneration, worldGeneration,
+                    args->verbose
+                );
+                continue;
+            }
             buildWorld(
-                possibleWorldKB, possibleWorldRevertKB, 
+                possibleWorldKB, 
                 determinedInNWorlds, 
-                POSSIBLE_WORLDS_FOR_PROB, POSSIBLE_WORLD_GENERATED, 
-                rs, 
+                POSSIBLE_WORLDS_FOR_PROB, 
+                rs, &rng, 
                 myGeneration, worldGeneration,
                 isroleIndexes, notroleIndexes, 
                 poisonedIndexes, notPoisonedIndexes, 
                 isPoisonedIndexes, isNotPoisonedIndexes,
-                killedIndexes, notKilledIndexes
+                killedIndexes, notKilledIndexes,
+                args->verbose
             );
         }
 
-        if (myGeneration == *worldGeneration) 
+        if (!isStaleGeneration(myGeneration, worldGeneration)) 
         {
-            pthread_mutex_lock(&problock);   // Lock before accessing shared data 
-                // Critical section
-                if (myGeneration == *worldGeneration) 
-                {                 
-                    mergeProbKnowledge(worldTally, determinedInNWorlds);
-                    *reRenderCall = true;
-                }
-            pthread_mutex_unlock(&problock); // Unlock after done
-
-            
+            //Readers skip tallies from old generations so no lock is needed if the generation moves on now
+            publishTally(publishedTally, determinedInNWorlds, myGeneration);
+            *reRenderCall = true;
         }
         else 
         {
-            myGeneration = *worldGeneration;
+            myGeneration = atomic_load(worldGeneration);
+            rs = pinRuleSet(ruleSets, args->worker);
         }
     }
 
     return NULL;
 }
 
+#define CACHE_WORLDS_PER_TASK 32 //Cached worlds checked per pool task
+
+/*
+ * Shared state of a cache revalidation spread over a sampler pool
+*/
+struct revalidateCacheArgs
+{
+    CachedKnowledgeBases* cache;
+    KnowledgeBase* kb;
+    RuleSet* rs;
+    int firstNewRule; //Rules before this were already infered in every cached world
+    ProbKnowledgeBase** tallies; //Tally of surviving worlds for each worker
+};
+
 /**
- * updateCacheWithNewKB()
+ * revalidateCachedWorlds() - pool task checking a block of cached worlds against the new knowledge base
+ * each world is independent so only the worker's own tally is written
  * 
+ * @void_arg the revalidateCacheArgs
+ * @task the block of worlds
+ * @worker the worker running the task
+*/
+static void revalidateCachedWorlds(void* void_arg, int task, int worker)
+{
+    struct revalidateCacheArgs* args = (struct revalidateCacheArgs*) void_arg;
+    CachedKnowledgeBases* cache = args->cache;
+
+    int end = (task+1)*CACHE_WORLDS_PER_TASK;
+    if (end > cache->NUM_LIVE) end = cache->NUM_LIVE;
+    for (int position = task*CACHE_WORLDS_PER_TASK; position < end; position++)
+    {
+        int i = cache->LIVE_SLOTS[position];
+        KnowledgeBase* world = cache->POSSIBLE_WORLDS_FOR_PROB[i];
+
+        //The world was infered before, so only the new knowledge and new rules need checking
+        long changedWords[NUM_SETS] = {0};
+        mergeKnowledgeTracked(world, args->kb, changedWords);
+        if (hasContradictionInChangedWords(world, changedWords) || 
+            inferknowledgeBaseFromNewRules(args->rs, world, changedWords, args->firstNewRule, NUM_SOLVE_STEPS, 0) == -1)
+        {
+            cache->value[i] = NAN;
+            continue;
+        }
+        addKBtoProbTally(world, args->tallies[worker], cache->value[i]);
+    }
+}
+
+/**
+ * updateCacheWithNewKB() - remove cached worlds that contradict the updated knowledge base and rules
+ * and tally the ones that survive, the worlds are split over the pool
  * 
+ * @cache the cached worlds
+ * @kb the updated knowledge base
+ * @rs the updated rules
+ * @pool the pool to lend the work to (NULL to do it all on this thread)
+ * @tally OUTPUTS the tally of the surviving worlds
  */
-void updateCacheWithNewKB(CachedKnowledgeBases* cache, KnowledgeBase* kb, RuleSet* rs)
+void updateCacheWithNewKB(CachedKnowledgeBases* cache, KnowledgeBase* kb, RuleSet* rs, SamplerPool* pool, ProbKnowledgeBase* tally)
+{
+    int numWorkers = pool != NULL ? pool->NUM_THREADS+1 : 1;
+    ProbKnowledgeBase* tallies[numWorkers];
+    for (int i = 0; i < numWorkers; i++) tallies[i] = initProbKB(kb);
+
+    struct revalidateCacheArgs args = {cache, kb, rs, cache->NUM_RULES_INFERED, tallies};
+    int numTasks = (cache->NUM_LIVE + CACHE_WORLDS_PER_TASK - 1) / CACHE_WORLDS_PER_TASK;
+    runOnSamplerPool(pool, &revalidateCachedWorlds, &args, numTasks);
+    cache->NUM_RULES_INFERED = rs->NUM_RULES;
+    removeInvalidKBsFromCache(cache);
+
+    //Reduce the workers tallies
+    resetProbKnowledgeBase(tally);
+    for (int i = 0; i < numWorkers; i++)
+    {
+        mergeProbKnowledge(tally, tallies[i]);
+        freeProbKB(tallies[i]);
+    }
+}
+#define PROBES_PER_TASK 8 //Role probes run per pool task
+
+/*
+ * Shared state of a round of role probes spread over a sampler pool
+*/
+struct probeRoleArgs
+{
+    RuleSet* rs;
+    int* probes; //Function literal of each role assumed (see FUNCTION_LITERAL())
+    int numProbes;
+    KnowledgeBase** scratch; //Copy of the knowledge base for each worker, probes are undone with its trail
+    char* failed; //Set for each probe that leads to a contradiction
+};
+
+/**
+ * probeRoles() - pool task assuming a block of roles one at a time to see which lead to a contradiction
+ * 
+ * @void_arg the probeRoleArgs
+ * @task the block of probes
+ * @worker the worker running the task
+*/
+static void probeRoles(void* void_arg, int task, int worker)
+{
+    struct probeRoleArgs* args = (struct probeRoleArgs*) void_arg;
+    KnowledgeBase* scratch = args->scratch[worker];
+
+    int end = (task+1)*PROBES_PER_TASK;
+    if (end > args->numProbes) end = args->numProbes;
+    for (int probe = task*PROBES_PER_TASK; probe < end; probe++)
+    {
+        int literal = args->probes[probe];
+        int trailMark = getTrailMark(scratch);
+
+        long changedWords[NUM_SETS] = {0};
+        addKnowledge(scratch, LITERAL_SET(literal), LITERAL_ELEMENT(literal), LITERAL_FUNCTION(literal));
+        markFunctionChanged(changedWords, LITERAL_SET(literal), LITERAL_FUNCTION(literal));
+        if (inferImplicitFactsIncremental(scratch, args->rs, changedWords, NUM_SOLVE_STEPS, 0)) args->failed[probe] = 1;
+
+        undoTrail(scratch, trailMark);
+    }
+}
+
+/**
+ * probeRoleFacts() - assume each role no player is known to have or not have (is_<ROLE>_[NIGHTn]) one at a time
+ * and add that the player isn't the role if inference finds a contradiction, the probes are split over the pool
+ * 
+ * @kb the knowledge base, must already be infered
+ * @rs the ruleset
+ * @pool the pool to lend the work to (NULL to do it all on this thread)
+ * 
+ * @return the number of facts added, -1 if the knowledge base turned out to have a contradiction
+*/
+int probeRoleFacts(KnowledgeBase* kb, RuleSet* rs, SamplerPool* pool)
 {
-    for (int i = 0; i < MAX_CACHED_WORLDS; i++)
+    int isroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES];
+    int notroleIndexes[NUM_DAYS][NUM_BOTCT_ROLES];
+    int poisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    int notPoisonedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    int isPoisonedIndexes[NUM_DAYS];
+    int isNotPoisonedIndexes[NUM_DAYS];
+    int killedIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    int notKilledIndexes[NUM_DAYS][MAX_SET_ELEMENTS];
+    getWorldFunctionIDs(
+        kb, 
+        isroleIndexes, notroleIndexes, 
+        poisonedIndexes, notPoisonedIndexes, 
+        isPoisonedIndexes, isNotPoisonedIndexes,
+        killedIndexes, notKilledIndexes
+    );
+
+    int numWorkers = pool != NULL ? pool->NUM_THREADS+1 : 1;
+    KnowledgeBase* scratch[numWorkers];
+    for (int i = 0; i < numWorkers; i++)
     {
-        if (isnan(cache->value[i]) == 0)
+        scratch[i] = initKBFromTemplate(kb);
+        scratch[i]->TRAIL = initKBTrail();
+    }
+    int maxProbes = NUM_DAYS * kb->SET_SIZES[0] * NUM_BOTCT_ROLES;
+    int* probes = (int*) malloc(maxProbes * sizeof(int));
+    int* notProbes = (int*) malloc(maxProbes * sizeof(int));
+    char* failed = (char*) malloc(maxProbes * sizeof(char));
+    if (probes == NULL || notProbes == NULL || failed == NULL)
+    {
+        printf("MALLOC FAILED!\n");
+        exit(1);
+    }
+
+    //Each round can rule out roles that the last round's facts make impossible, so repeat until nothing new is found
+    int numFacts = 0;
+    while (1)
+    {
+        int numProbes = 0;
+        for (int night = 0; night < NUM_DAYS; night++)
+        {
+            for (int player = 0; player < kb->SET_SIZES[0]; player++)
+            {
+                for (int roleID = 0; roleID < NUM_BOTCT_ROLES; roleID++)
+                {
+                    if (isKnown(kb, 0, player, isroleIndexes[night][roleID])) continue;
+                    if (isKnown(kb, 0, player, notroleIndexes[night][roleID])) continue;
+                    probes[numProbes] = FUNCTION_LITERAL(0, player, isroleIndexes[night][roleID]);
+                    notProbes[numProbes] = FUNCTION_LITERAL(0, player, notroleIndexes[night][roleID]);
+                    failed[numProbes] = 0;
+                    numProbes++;
+                }
+            }
+        }
+        if (numProbes == 0) break;
+
+        for (int i = 0; i < numWorkers; i++)
         {
-            mergeKnowledge(cache->POSSIBLE_WORLDS_FOR_PROB[i], kb);
+            copyTo(scratch[i], kb);
+            scratch[i]->TRAIL->LENGTH = 0; //Nothing to undo in a fresh copy
+        }
+        struct probeRoleArgs args = {rs, probes, numProbes, scratch, failed};
+        runOnSamplerPool(pool, &probeRoles, &args, (numProbes + PROBES_PER_TASK - 1) / PROBES_PER_TASK);
 
-            if(inferImplicitFacts(cache->POSSIBLE_WORLDS_FOR_PROB[i], rs, 5, 0)) cache->value[i] = NAN;
-            //NOTE: replace with some level of inference to catch more contradictions
-            //if (hasExplicitContradiction(cache->POSSIBLE_WORLDS_FOR_PROB[i])) 
-            
+        int numNewFacts = 0;
+        for (int probe = 0; probe < numProbes; probe++)
+        {
+            if (failed[probe] == 0) continue;
+            int literal = notProbes[probe];
+            addKnowledge(kb, LITERAL_SET(literal), LITERAL_ELEMENT(literal), LITERAL_FUNCTION(literal));
+            numNewFacts++;
         }
+        if (numNewFacts == 0) break;
+        numFacts += numNewFacts;
+
+        if (inferImplicitFacts(kb, rs, NUM_SOLVE_STEPS, 0))
+        { //Every role of some player contradicts
+            numFacts = -1;
+            break;
+        }
+    }
+
+    for (int i = 0; i < numWorkers; i++)
+    {
+        free(scratch[i]->TRAIL->ENTRIES);
+        free(scratch[i]->TRAIL);
+        free(scratch[i]);
     }
-}
\ No newline at end of file
+    free(probes);
+    free(notProbes);
+    free(failed);
+    return numFacts;
+}
@@ -27,12 +27,63 @@
 #include "rules.h"
 #include "knowledge.h"
 #include "rules.h"
+#include "cache.h"
+#include "util.h"
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
 
 #define NUM_SOLVE_STEPS 5
 
+extern pthread_mutex_t exampleworldlock; // Mutex to protect shared data
+extern pthread_mutex_t cacheworldlock;
+
 int inferImplicitFacts(KnowledgeBase* kb, RuleSet* rs, int numRounds, int verbose);
 
+int inferImplicitFactsIncremental(KnowledgeBase* kb, RuleSet* rs, long changedWords[NUM_SETS], int numRounds, int verbose);
+
+/*
+ * The running tally of one sampler thread for the current world generation
+ * Only its thread writes it, a single reader copies it out and retries if SEQUENCE moved (a seqlock)
+*/
+typedef struct {
+    atomic_uint SEQUENCE; //Odd while the thread is writing
+    int GENERATION; //World generation the tally was sampled in
+    ProbKnowledgeBase* TALLY;
+    ProbKnowledgeBase* SNAPSHOT; //Reader's copy, only touched by the (single) reader
+} PublishedTally;
+
+/**
+ * initPublishedTally() - allocate an empty published tally for a sampler thread
+ * 
+ * @kb - knowledge base the tallies are sized for
+ * 
+ * Return: pointer to the published tally
+*/
+PublishedTally* initPublishedTally(KnowledgeBase* kb);
+
+/**
+ * publishTally() - add a batch of worlds to a thread's published tally
+ * only ever called by the thread that owns the published tally
+ * 
+ * @published - the thread's published tally
+ * @batch - worlds found since the last publish
+ * @generation - world generation the batch was sampled in
+*/
+void publishTally(PublishedTally* published, ProbKnowledgeBase* batch, int generation);
+
+/**
+ * sumPublishedTallies() - sum the published tallies of the current generation without locking the samplers
+ * only one thread may call this for a set of published tallies (it reads into their SNAPSHOT)
+ * 
+ * @total - tally to write the sum into
+ * @base - tally the samplers are adding to (e.g. the cached worlds), or NULL
+ * @published - the published tallies of each thread
+ * @numPublished - number of published tallies
+ * @generation - current world generation, tallies from older generations are skipped
+*/
+void sumPublishedTallies(ProbKnowledgeBase* total, ProbKnowledgeBase* base, PublishedTally** published, int numPublished, int generation);
+
 void* getProbApproxContinuous(void* void_arg);
 /*
  * struct to store function args for getProbApprox()
@@ -41,20 +92,138 @@ struct getProbApproxArgs
 {
     KnowledgeBase* kb;
     KnowledgeBase* possibleWorldKB;
-    KnowledgeBase**** possibleWorldRevertKB;
     ProbKnowledgeBase* determinedInNWorlds;
-    ProbKnowledgeBase* worldTally;
+    PublishedTally* publishedTally; //Where this thread publishes its worlds
     CachedKnowledgeBases* POSSIBLE_WORLDS_FOR_PROB;
-    int (*POSSIBLE_WORLD_GENERATED)[MAX_SET_ELEMENTS][NUM_BOTCT_ROLES][NUM_DAYS];
-    RuleSet* rs;
-    int* worldGeneration;
+    VersionedRuleSet* ruleSets; //Each generation the thread pins the latest snapshot
+    atomic_int* worldGeneration; //Bumped whenever the knowledge base changes, stale searches stop early
     bool* reRenderCall;
     int numIterations;
+    unsigned long seed; //Seed for this threads random number generator
+    int verbose; //Print each world as it is found
+    int satBackend; //Build witness worlds with the SAT solver (see sat.h) instead of backtracking, the tally is then not a probability estimate
+    struct SamplerPool* pool; //Pool the thread belongs to, or NULL if it runs on its own
+    int worker; //Index of the thread in its pool
 };
 
+/*
+ * A finite job lent to a sampler pool, tasks 0..n-1 are split into one range per worker (plus the caller)
+ * workers claim tasks from their own range then steal from the others once it runs out
+*/
+typedef struct {
+    void (*RUN)(void* arg, int task, int worker);
+    void* ARG;
+    int NUM_RANGES;
+    atomic_int* NEXT; //Next unclaimed task in each range
+    int* END; //End of each range
+    int ACTIVE; //Workers currently helping (guarded by the pool lock)
+} PoolJob;
+
+/*
+ * Sampler threads sized at runtime
+ * between batches of worlds each thread checks if it should park or help with a lent job
+*/
+typedef struct SamplerPool {
+    int NUM_THREADS;
+    pthread_t* THREADS;
+    struct getProbApproxArgs* ARGS;
+    PublishedTally** PUBLISHED_TALLIES; //Published tally of each thread (see sumPublishedTallies())
+
+    pthread_mutex_t LOCK;
+    pthread_cond_t WAKE; //Signalled when the pool is resumed or lent a job
+    pthread_cond_t JOB_DONE; //Signalled when the last worker leaves a job
+    atomic_int PAUSED; //Parked threads still help with jobs
+    atomic_int HAS_JOB; //Checked without the lock before looking at JOB
+    PoolJob* JOB;
+} SamplerPool;
+
+/**
+ * initSamplerPool() - allocate a pool of sampler threads (not started)
+ * 
+ * @numThreads number of threads, 0 to use one per hardware thread
+ * 
+ * @return pointer to the pool
+*/
+SamplerPool* initSamplerPool(int numThreads);
+
 /**
- * updateCacheWithNewKB()
+ * startSamplerPool() - start every thread in the pool sampling worlds
  * 
+ * @pool the pool
+ * @args arguments shared by every thread, each thread gets its own working knowledge base,
+ * tallies and random stream (seed + thread index)
+*/
+void startSamplerPool(SamplerPool* pool, struct getProbApproxArgs* args);
+
+/**
+ * pauseSamplerPool() - park the threads after their current batch of worlds
+ * 
+ * @pool the pool
+*/
+void pauseSamplerPool(SamplerPool* pool);
+
+/**
+ * resumeSamplerPool() - wake parked threads to carry on sampling
+ * 
+ * @pool the pool
+*/
+void resumeSamplerPool(SamplerPool* pool);
+
+/**
+ * runOnSamplerPool() - run a job on the calling thread and any pool threads between batches
+ * returns once every task has finished, only one job may run at a time
+ * 
+ * @pool the pool (NULL to run every task on the calling thread)
+ * @run the task function, worker is in 0..NUM_THREADS (the caller is NUM_THREADS)
+ * @arg passed to run
+ * @numTasks number of tasks
+*/
+void runOnSamplerPool(SamplerPool* pool, void (*run)(void* arg, int task, int worker), void* arg, int numTasks);
+
+/**
+ * checkInToSamplerPool() - called by pool threads between batches to help with jobs and park while paused
+ * 
+ * @pool the pool
+ * @worker index of the calling thread
+*/
+void checkInToSamplerPool(SamplerPool* pool, int worker);
+
+/**
+ * getProbExact() - tally every combination of night 0 roles, kills and poisonings without a contradiction once,
+ * the combinations the backtracking sampler weights its worlds to count, so the night 0 role probabilities are exact
+ * each combination is tallied as the one complete world the SAT solver (see sat.h) found for it,
+ * so the functions of later nights are NOT exact and only show what one world per combination holds
+ * 
+ * @kb the knowledge base
+ * @rs the ruleset
+ * @tally OUTPUTS the tally
+ * @maxWorlds the most combinations to tally, 0 for no limit
+ * @timeBudget the most seconds to spend, 0 for no limit
+ * 
+ * @return 1 if every combination was tallied, 0 if the budget ran out (or the searches kept giving up) first
+*/
+int getProbExact(KnowledgeBase* kb, RuleSet* rs, ProbKnowledgeBase* tally, long maxWorlds, double timeBudget);
+
+/**
+ * probeRoleFacts() - assume each role no player is known to have or not have (is_<ROLE>_[NIGHTn]) one at a time
+ * and add that the player isn't the role if inference finds a contradiction, the probes are split over the pool
+ * 
+ * @kb the knowledge base, must already be infered
+ * @rs the ruleset
+ * @pool the pool to lend the work to (NULL to do it all on this thread)
+ * 
+ * @return the number of facts added, -1 if the knowledge base turned out to have a contradiction
+*/
+int probeRoleFacts(KnowledgeBase* kb, RuleSet* rs, SamplerPool* pool);
+
+/**
+ * updateCacheWithNewKB() - remove cached worlds that contradict the updated knowledge base and rules
+ * and tally the ones that survive, the worlds are split over the pool
  * 
+ * @cache the cached worlds
+ * @kb the updated knowledge base
+ * @rs the updated rules
+ * @pool the pool to lend the work to (NULL to do it all on this thread)
+ * @tally OUTPUTS the tally of the surviving worlds
  */
-void updateCacheWithNewKB(CachedKnowledgeBases* cache, KnowledgeBase* kb, RuleSet* rs);
\ No newline at end of file
+void updateCacheWithNewKB(CachedKnowledgeBases* cache, KnowledgeBase* kb, RuleSet* rs, SamplerPool* pool, ProbKnowledgeBase* tally);
\ No newline at end of file
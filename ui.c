@@ -839,7 +839,7 @@ void empathPing(int playerIDinfoFrom, int countEvil, int night, KnowledgeBase* k
         isDead = isKnownName(kb, "PLAYERS", playerY, buff);
     } while (isDead == 1);
 
-    printf("Empath ping on %s and %s\n", kb->ELEMENT_NAMES[0][playerX], kb->ELEMENT_NAMES[0][playerY]);
+    printf("Empath ping on %s and %s\n", kb->SCHEMA->ELEMENT_NAMES[0][playerX], kb->SCHEMA->ELEMENT_NAMES[0][playerY]);
     
     
     if (countEvil == 0)
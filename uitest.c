@@ -59,6 +59,7 @@
 #include <SDL2/SDL_ttf.h>
 #include <stdbool.h>
 #include <pthread.h>
+#include <time.h>
 
 #include "uitest.h"
 
@@ -89,8 +90,9 @@ bool reRenderCall = false;
 //Viewing which night
 int currentNight = 0;
 
-//Viewing specific world
-int soloCachedWorld = -1;
+//Viewing specific world (a copy, the cache may evict the world while it is shown)
+bool viewingSoloWorld = false;
+KnowledgeBase* SOLO_WORLD = NULL;
 
 //Which menu is open
 const int MAX_BUTTON_OPTIONS = NUM_BOTCT_ROLES+1;
@@ -106,30 +108,24 @@ int subSubSubSubSubMenuSelected[MAX_BUTTON_OPTIONS*3];
 KnowledgeBase* KNOWLEDGE_BASE = NULL;
 KnowledgeBase* REVERT_KB = NULL;
 
-ProbKnowledgeBase* WORLD_TALLY = NULL;
+ProbKnowledgeBase* WORLD_TALLY = NULL; //Sum of the cached worlds and each thread's published tally, rebuilt on render
+ProbKnowledgeBase* CACHE_TALLY = NULL; //Tally of the cached worlds when the knowledge base last changed
 
-int WORLD_GENERATION = 1;
+atomic_int WORLD_GENERATION = 1; //Bumped when the knowledge base changes so samplers drop stale worlds
 
-RuleSet* RULE_SET = NULL;
+RuleSet* RULE_SET = NULL; //Only edited on the UI thread, samplers read published snapshots
+VersionedRuleSet* RULE_SET_VERSIONS = NULL;
 
 
-const int NUM_THREADS = 12;
+const int NUM_THREADS = 0; //Number of sampler threads, 0 to use one per hardware thread
 const int NUM_ITERATIONS = 8;
+const unsigned long RAND_SEED = 0; //Seed for the world samplers, 0 to seed from the time (set to reproduce runs)
 
-ProbKnowledgeBase* threadTallies[NUM_THREADS];
-KnowledgeBase* possibleWorldKB[NUM_THREADS];
-KnowledgeBase**** possibleWorldTempKB[NUM_THREADS];
-struct getProbApproxArgs* threadArgs[NUM_THREADS];
+SamplerPool* SAMPLER_POOL = NULL;
 
 
 CachedKnowledgeBases* POSSIBLE_WORLDS_FOR_PROB;
-int POSSIBLE_WORLD_GENERATED[MAX_SET_ELEMENTS][NUM_BOTCT_ROLES][NUM_DAYS];
-//Thread object
-pthread_t threads[NUM_THREADS];
-
-pthread_mutex_t problock; // Mutex to protect shared data
-pthread_mutex_t exampleworldlock; // Mutex to protect shared data
-pthread_mutex_t cacheworldlock;
+const int CACHE_CAPACITY = MAX_CACHED_WORLDS; //Most worlds kept for the probabilities, a random sample is kept once full
 
 /***************************************************
  * UI CODE
@@ -311,7 +307,15 @@ void viewSoloWorld(int eventID)
     int soloWorldPlayer = eventID;
 
     //Find cached world
-    soloCachedWorld = POSSIBLE_WORLD_GENERATED[soloWorldPlayer][soloWorldRole][soloWorldNight];
+    pthread_mutex_lock(&cacheworldlock);
+        int slot = getExampleWorld(POSSIBLE_WORLDS_FOR_PROB, soloWorldPlayer, soloWorldRole, soloWorldNight);
+        if (slot != -1)
+        {
+            if (SOLO_WORLD == NULL) SOLO_WORLD = initKBFromTemplate(KNOWLEDGE_BASE);
+            copyTo(SOLO_WORLD, POSSIBLE_WORLDS_FOR_PROB->POSSIBLE_WORLDS_FOR_PROB[slot]);
+        }
+        viewingSoloWorld = slot != -1;
+    pthread_mutex_unlock(&cacheworldlock);
 
     
     reRenderCall = true;
@@ -319,7 +323,7 @@ void viewSoloWorld(int eventID)
 
 void viewProbWorld(int eventID)
 {
-    soloCachedWorld = -1;
+    viewingSoloWorld = false;
     reRenderCall = true;
 }
 
@@ -503,7 +507,7 @@ void makeTable(KnowledgeBase* kb, ProbKnowledgeBase* probkb, TTF_Font *FONT, int
         y += Y_STEP;
         x = X_START - X_STEP;
         
-        snprintf(buff, STRING_BUFF_SIZE, "%s", kb->ELEMENT_NAMES[0][element]);
+        snprintf(buff, STRING_BUFF_SIZE, "%s", kb->SCHEMA->ELEMENT_NAMES[0][element]);
         addTextBox(
             x, y, X_WIDTH, Y_WIDTH, //bb
             0, 0, 0, //Box colour
@@ -541,7 +545,7 @@ void makeTable(KnowledgeBase* kb, ProbKnowledgeBase* probkb, TTF_Font *FONT, int
         snprintf(buff, 64, "is_DEAD_[NIGHT%d]", night);
         int isDead = isKnownName(kb, "PLAYERS", element, buff); 
 
-        //printTrucatedStr(kb->ELEMENT_NAMES[0][element], 9);
+        //printTrucatedStr(kb->SCHEMA->ELEMENT_NAMES[0][element], 9);
         for (int role = 0; role < NUM_BOTCT_ROLES; role++)
         {
             //Only print roles in the script
@@ -588,7 +592,7 @@ void makeTable(KnowledgeBase* kb, ProbKnowledgeBase* probkb, TTF_Font *FONT, int
 
                 if (isNotRoleCertain == 0)
                 {
-                    if (POSSIBLE_WORLD_GENERATED[element][role][night] != -1)
+                    if (getExampleWorld(POSSIBLE_WORLDS_FOR_PROB, element, role, night) != -1)
                     {
                         addTextBox(
                             x, y, X_WIDTH, Y_WIDTH, //bb
@@ -1026,7 +1030,7 @@ void makeSingleWorldTable(KnowledgeBase* kb, TTF_Font *FONT, int night)
     {
         y += Y_STEP;
         x = X_START - X_STEP;
-        snprintf(buff, STRING_BUFF_SIZE, "%s", kb->ELEMENT_NAMES[0][element]);
+        snprintf(buff, STRING_BUFF_SIZE, "%s", kb->SCHEMA->ELEMENT_NAMES[0][element]);
         addTextBox(
             x, y, X_WIDTH, Y_WIDTH, //bb
             0, 0, 0, //Box colour
@@ -1064,7 +1068,7 @@ void makeSingleWorldTable(KnowledgeBase* kb, TTF_Font *FONT, int night)
         snprintf(buff, 64, "is_DEAD_[NIGHT%d]", night);
         int isDead = isKnownName(kb, "PLAYERS", element, buff); 
 
-        //printTrucatedStr(kb->ELEMENT_NAMES[0][element], 9);
+        //printTrucatedStr(kb->SCHEMA->ELEMENT_NAMES[0][element], 9);
         for (int role = 0; role < NUM_BOTCT_ROLES; role++)
         {
             //Only print roles in the script
@@ -1355,13 +1359,13 @@ void updateUITable(KnowledgeBase* kb, ProbKnowledgeBase* probKB, TTF_Font *FONT,
 {
     currentNight = night;
     resetScreen(0);
-    if (soloCachedWorld == -1)
+    if (!viewingSoloWorld)
     {
         makeTable(kb, probKB, FONT, night);
     }
     else
     {
-        makeSingleWorldTable(POSSIBLE_WORLDS_FOR_PROB->POSSIBLE_WORLDS_FOR_PROB[soloCachedWorld], FONT, night);
+        makeSingleWorldTable(SOLO_WORLD, FONT, night);
     }
 }
 
@@ -1477,6 +1481,9 @@ void selectSubSubSubSubSubMenu(int eventID)
 void finish()
 {
     int contradiction = inferImplicitFacts(KNOWLEDGE_BASE, RULE_SET, NUM_SOLVE_STEPS, 0);
+
+    //Rule out roles that contradict on their own so the samplers never try them
+    if (contradiction == 0 && probeRoleFacts(KNOWLEDGE_BASE, RULE_SET, SAMPLER_POOL) == -1) contradiction = 1;
     
     if (contradiction == 0)
     { //Optimise ruleset only if no contradictions were produced
@@ -1496,31 +1503,15 @@ void finish()
 
     if (contradiction == 0)
     {
+        //Samplers pin the new rules when they see the generation change
+        publishRuleSet(RULE_SET_VERSIONS, RULE_SET);
+
         pthread_mutex_lock(&cacheworldlock);   // Lock before accessing shared data
-        pthread_mutex_lock(&problock);   // Lock before accessing shared data 
         // Critical section 
             WORLD_GENERATION++;
-            //Find contradictions in cache after updated knowledge base
-            updateCacheWithNewKB(POSSIBLE_WORLDS_FOR_PROB, KNOWLEDGE_BASE, RULE_SET);
-            //Compute total tally after culled cache
-            resetProbKBWithCache(WORLD_TALLY, POSSIBLE_WORLDS_FOR_PROB);
-
-            for (int i = 0; i < MAX_SET_ELEMENTS; i++)
-            {
-                for (int j = 0; j < NUM_BOTCT_ROLES; j++)
-                {
-                    for (int night = 0; night < NUM_DAYS; night++)
-                    {
-                        int index = POSSIBLE_WORLD_GENERATED[i][j][night];
-                        if (isnan(POSSIBLE_WORLDS_FOR_PROB->value[index]))
-                        {
-                            POSSIBLE_WORLD_GENERATED[i][j][night] = -1;
-                        }
-                    }
-                    
-                }
-            }
-        pthread_mutex_unlock(&problock); // Unlock after done
+            //Find contradictions in cache after updated knowledge base (samplers that see the new generation help)
+            //and tally what is left, threads publish what they find on top of this
+            updateCacheWithNewKB(POSSIBLE_WORLDS_FOR_PROB, KNOWLEDGE_BASE, RULE_SET, SAMPLER_POOL, CACHE_TALLY);
         pthread_mutex_unlock(&cacheworldlock); // Unlock after done
     }
     
@@ -2258,7 +2249,7 @@ void updateSubSubSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubSubSubMenuSelected[MAX_BUTTON_OPTIONS+player+1] == 1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -2452,7 +2443,7 @@ void updateSubSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubSubMenuSelected[player+1] == 1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -2962,7 +2953,7 @@ void updateSubSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubSubMenuSelected[player+1] == 1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -2981,7 +2972,7 @@ void updateSubSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubSubMenuSelected[player+1] == 1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -3034,7 +3025,7 @@ void updateSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubMenuOpen == player+1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -3054,7 +3045,7 @@ void updateSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubMenuOpen == player+1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -3102,7 +3093,7 @@ void updateSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubMenuOpen == player+1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -3121,7 +3112,7 @@ void updateSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubMenuOpen == player+1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -3197,7 +3188,7 @@ void updateSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubMenuOpen == player+1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -3216,7 +3207,7 @@ void updateSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubMenuOpen == player+1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -3235,7 +3226,7 @@ void updateSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubMenuOpen == player+1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -3254,7 +3245,7 @@ void updateSubSubMenu(TTF_Font *FONT, KnowledgeBase* kb)
             for (int player = 0; player < kb->SET_SIZES[0]; player++)
             {
                 getButtonColours(subSubSubMenuOpen == player+1, &red, &green, &blue, &selectedRed, &selectedGreen, &selectedBlue);
-                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->ELEMENT_NAMES[0][player]);
+                snprintf(buff, STRING_BUFF_SIZE, "Player: %s", kb->SCHEMA->ELEMENT_NAMES[0][player]);
                 addTextBox(
                     x, y, X_WIDTH, Y_WIDTH, //bb
                     red, green, blue, //Box colour
@@ -3511,95 +3502,35 @@ int main() {
 
     initScript(&RULE_SET, &KNOWLEDGE_BASE, SCRIPT, NUM_PLAYERS, NUM_MINIONS, NUM_DEMONS, BASE_OUTSIDERS);
 
-    REVERT_KB = initKB(NUM_PLAYERS); //For backup incase of contradictions
-    WORLD_TALLY = initProbKB();
+    REVERT_KB = initKBFromTemplate(KNOWLEDGE_BASE); //For backup incase of contradictions
+    WORLD_TALLY = initProbKB(KNOWLEDGE_BASE);
+    CACHE_TALLY = initProbKB(KNOWLEDGE_BASE);
 
     copyTo(REVERT_KB, KNOWLEDGE_BASE);
 
-    getNames(KNOWLEDGE_BASE->ELEMENT_NAMES, NUM_PLAYERS);
+    getNames(KNOWLEDGE_BASE->SCHEMA->ELEMENT_NAMES, NUM_PLAYERS);
 
     //Init threads
-    for (int i = 0; i < NUM_THREADS; i++)
-    {
-        possibleWorldKB[i] = initKBFromTemplate(KNOWLEDGE_BASE);
-        threadTallies[i] = initProbKB();
-        possibleWorldTempKB[i] = (KnowledgeBase****)malloc(NUM_DAYS * sizeof(KnowledgeBase****));
-        //Create arguments in strctures to pass into new thread
-        threadArgs[i] = (struct getProbApproxArgs*) malloc(sizeof(struct getProbApproxArgs));
-        if (possibleWorldTempKB[i] == NULL)
-        {
-            printf("MALLOC FAILED!\n");
-            return 1;
-        }
-        for (int j = 0; j < NUM_DAYS; j++)
-        {
-            possibleWorldTempKB[i][j] = (KnowledgeBase***)malloc(MAX_SET_ELEMENTS * sizeof(KnowledgeBase***));
-            if (possibleWorldTempKB[i][j] == NULL)
-            {
-                printf("MALLOC FAILED!\n");
-                return 1;
-            }
-            
-            for (int k = 0; k < MAX_SET_ELEMENTS; k++)
-            {
-                //possibleWorldTempKB[i][j][k] = (KnowledgeBase*)malloc(NUM_DAYS * sizeof(KnowledgeBase*));
-                
-                possibleWorldTempKB[i][j][k] = (KnowledgeBase**)malloc(3 * sizeof(KnowledgeBase**));
-                if (possibleWorldTempKB[i][j][k] == NULL)
-                {
-                    printf("MALLOC FAILED!\n");
-                    return 1;
-                }
-                for (int l = 0; l < 3; l++)
-                {
-                    //possibleWorldTempKB[i][j][k][l] = initKB(NUM_PLAYERS);
-                    possibleWorldTempKB[i][j][k][l] = initKBFromTemplate(KNOWLEDGE_BASE);
-                    if (possibleWorldTempKB[i][j][k][l] == NULL)
-                    {
-                        printf("MALLOC FAILED!\n");
-                        return 1;
-                    }
-                }
-            }
-        }
-    }
+    SAMPLER_POOL = initSamplerPool(NUM_THREADS);
 
-    POSSIBLE_WORLDS_FOR_PROB = initCachedKB(KNOWLEDGE_BASE);
+    unsigned long seed = RAND_SEED != 0 ? RAND_SEED : (unsigned long) time(NULL);
     //Init zone to store data
-    for (int i = 0; i < MAX_SET_ELEMENTS; i++)
-    {
-        for (int j = 0; j < NUM_BOTCT_ROLES; j++)
-        {
-            for (int night = 0; night < NUM_DAYS; night++)
-            {
-                POSSIBLE_WORLD_GENERATED[i][j][night] = -1;
-            }
-            //POSSIBLE_WORLDS_FOR_PROB[i][j] = initKB(NUM_PLAYERS);
-            //copyTo(POSSIBLE_WORLDS_FOR_PROB[i][j], KNOWLEDGE_BASE);
-        }
-    }
-
-    //Generate NUM_THREADS thread arguments
-    for (int i = 0; i < NUM_THREADS; i++)
-    {
-        threadArgs[i]->kb = KNOWLEDGE_BASE; //We MUST promise to never touch this in the thread
-        threadArgs[i]->possibleWorldKB = possibleWorldKB[i]; //Working block of memory
-        threadArgs[i]->possibleWorldRevertKB = possibleWorldTempKB[i]; //Working block of memory
-        threadArgs[i]->determinedInNWorlds = threadTallies[i]; //The output tallies
-        threadArgs[i]->worldTally = WORLD_TALLY;
-        threadArgs[i]->POSSIBLE_WORLDS_FOR_PROB=POSSIBLE_WORLDS_FOR_PROB;
-        threadArgs[i]->POSSIBLE_WORLD_GENERATED=&POSSIBLE_WORLD_GENERATED;
-        threadArgs[i]->worldGeneration = &WORLD_GENERATION;
-        threadArgs[i]->reRenderCall = &reRenderCall;
-        threadArgs[i]->rs = RULE_SET;
-        threadArgs[i]->numIterations = NUM_ITERATIONS;
-        
-    }
-    //Set off NUM_THREADS-1 threads
-    for (int i = 0; i < NUM_THREADS; i++)
-    {
-        pthread_create(&threads[i], NULL, &getProbApproxContinuous, (void *) threadArgs[i]);
-    }
+    POSSIBLE_WORLDS_FOR_PROB = initCachedKB(KNOWLEDGE_BASE, CACHE_CAPACITY, seed);
+    printf("Sampling worlds with seed %lu on %d threads\n", seed, SAMPLER_POOL->NUM_THREADS);
+
+    //Arguments shared by every thread, the pool gives each its own working memory
+    struct getProbApproxArgs samplerArgs;
+    samplerArgs.kb = KNOWLEDGE_BASE; //We MUST promise to never touch this in the thread
+    samplerArgs.POSSIBLE_WORLDS_FOR_PROB = POSSIBLE_WORLDS_FOR_PROB;
+    samplerArgs.worldGeneration = &WORLD_GENERATION;
+    samplerArgs.reRenderCall = &reRenderCall;
+    RULE_SET_VERSIONS = initVersionedRuleSet(RULE_SET, SAMPLER_POOL->NUM_THREADS);
+    samplerArgs.ruleSets = RULE_SET_VERSIONS;
+    samplerArgs.numIterations = NUM_ITERATIONS;
+    samplerArgs.seed = seed;
+    samplerArgs.verbose = 1;
+    samplerArgs.satBackend = 0;
+    startSamplerPool(SAMPLER_POOL, &samplerArgs);
     
     //Don't print rules
     //printRules(rs, kb);
@@ -3635,6 +3566,7 @@ int main() {
             reRenderCall = false;
             //printf("-TABLE!\n");
             
+            sumPublishedTallies(WORLD_TALLY, CACHE_TALLY, SAMPLER_POOL->PUBLISHED_TALLIES, SAMPLER_POOL->NUM_THREADS, WORLD_GENERATION);
             updateUITable(KNOWLEDGE_BASE, WORLD_TALLY, ARIAL_FONT, currentNight);
 
             //printf("-FIRST MENU!\n");
@@ -27,41 +27,146 @@
 #include <stdlib.h>
 #include <time.h>
 #include <ctype.h>
+#include <unistd.h>
 
 #include "util.h"
 #include "constants.h"
 
+/**
+ * initRandState() - seed a random number generator
+ *
+ * @rng - the generator to seed
+ * @seed - the seed (the same seed gives the same numbers)
+*/
+void initRandState(RandState* rng, unsigned long seed)
+{
+    //Spread the seed over the state with splitmix64 so similar seeds give unrelated streams
+    for (int i = 0; i < 4; i++)
+    {
+        seed += 0x9E3779B97F4A7C15UL;
+        unsigned long z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+        rng->STATE[i] = z ^ (z >> 31);
+    }
+}
+
+/**
+ * rotateLeft() - rotate the bits of x left by k
+*/
+static inline unsigned long rotateLeft(unsigned long x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * getRandLong() - returns the next random 64 bits from a generator
+ *
+ * @rng - the generator
+ * 
+ * @return random bits
+*/
+unsigned long getRandLong(RandState* rng)
+{
+    unsigned long* s = rng->STATE;
+    unsigned long result = rotateLeft(s[1] * 5, 7) * 9;
+    unsigned long t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft(s[3], 45);
+
+    return result;
+}
+
 /**
  * getRandInt() - returns a random integer between two values
  *
+ * @rng - the generator
  * @min - min number (inclusive)
  * @max - max number (exclusive)
  * 
  * @return min <= rand < max
 */
-int getRandInt(int min, int max)
+int getRandInt(RandState* rng, int min, int max)
+{
+    //Scale the top 32 bits into the range (avoids the bias and cost of %)
+    unsigned long range = (unsigned long) (max - min);
+    return (int) (((getRandLong(rng) >> 32) * range) >> 32) + min;
+}
+
+/**
+ * initRandChoices() - build a set of choices
+ *
+ * @choices - the choices to build
+ * @weights - weight of each choice (0 if unavaliable, 1 for uniform)
+ * @size - number of choices (at most MAX_RAND_CHOICES)
+*/
+void initRandChoices(RandChoices* choices, int weights[], int size)
+{
+    if (size > MAX_RAND_CHOICES)
+    {
+        printf("TOO MANY RANDOM CHOICES!\n");
+        exit(1);
+    }
+    choices->SIZE = size;
+    choices->TOTAL = 0;
+    choices->TREE[0] = 0;
+    for (int i = 0; i < size; i++)
+    {
+        choices->WEIGHTS[i] = weights[i];
+        choices->TREE[i+1] = weights[i];
+        choices->TOTAL += weights[i];
+    }
+    //Build in O(n) by pushing each partial sum up to its parent
+    for (int i = 1; i <= size; i++)
+    {
+        int parent = i + (i & -i);
+        if (parent <= size) choices->TREE[parent] += choices->TREE[i];
+    }
+}
+
+/**
+ * setRandChoiceWeight() - change the weight of a choice
+ *
+ * @choices - the choices
+ * @index - the choice to change
+ * @weight - the new weight (0 to remove the choice)
+*/
+void setRandChoiceWeight(RandChoices* choices, int index, int weight)
 {
-    return (rand() % (max - min)) + min;
+    int change = weight - choices->WEIGHTS[index];
+    choices->WEIGHTS[index] = weight;
+    choices->TOTAL += change;
+    for (int i = index+1; i <= choices->SIZE; i += i & -i) choices->TREE[i] += change;
 }
 
 /**
- * getRandIntNotIn() - returns a random integer between 0 and len(avaliable)
+ * getRandChoice() - pick a choice at random, with probability proportional to its weight
  *
- * @avaliable - is number avaliable
- * @numAvaliable - num avaliable
+ * @rng - the generator
+ * @choices - the choices (must have TOTAL > 0)
  * 
- * @return min <= rand < max
+ * @return the index of the choice
 */
-int getRandIntNotIn(int avaliable[], int numAvaliable)
+int getRandChoice(RandState* rng, RandChoices* choices)
 {
-    int rand = getRandInt(0, numAvaliable);
-        
+    int rand = getRandInt(rng, 0, choices->TOTAL);
+
+    //Walk down the tree to the first choice whose running total passes rand
     int selected = 0;
-    //Find avaliable role 
-    while(avaliable[selected] == 0 || rand > 0)
+    int step = 1;
+    while (step*2 <= choices->SIZE) step *= 2;
+    for (; step > 0; step /= 2)
     {
-        rand = avaliable[selected] == 1 ? rand - 1 : rand;
-        selected++;
+        if (selected + step <= choices->SIZE && choices->TREE[selected + step] <= rand)
+        {
+            selected += step;
+            rand -= choices->TREE[selected];
+        }
     }
     return selected;
 }
@@ -76,6 +181,18 @@ void initRand()
     srand(time(NULL));
 }
 
+/**
+ * getNumHardwareThreads() - number of threads the machine can run at once
+ * 
+ * @return number of online processors (at least 1)
+*/
+int getNumHardwareThreads()
+{
+    long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (numProcessors < 1) return 1;
+    return (int) numProcessors;
+}
+
 
 char* toLowerCase(char* str)
 {
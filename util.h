@@ -24,25 +24,82 @@
 
 #pragma once
 
+/*
+ * State of a xoshiro256** random number generator
+ * each thread owns its own so they don't share or lock any state
+*/
+typedef struct {
+    unsigned long STATE[4];
+} RandState;
+
+/**
+ * initRandState() - seed a random number generator
+ *
+ * @rng - the generator to seed
+ * @seed - the seed (the same seed gives the same numbers)
+*/
+void initRandState(RandState* rng, unsigned long seed);
+
+/**
+ * getRandLong() - returns the next random 64 bits from a generator
+ *
+ * @rng - the generator
+ * 
+ * @return random bits
+*/
+unsigned long getRandLong(RandState* rng);
+
 /**
  * getRandInt() - returns a random integer between two values
  *
+ * @rng - the generator
  * @min - min number (inclusive)
  * @max - max number (exclusive)
  * 
  * @return min <= rand < max
 */
-int getRandInt(int min, int max);
+int getRandInt(RandState* rng, int min, int max);
+
+#define MAX_RAND_CHOICES 128
+
+/*
+ * Weighted choices to pick from at random, stored as a Fenwick tree
+ * so picking and changing a weight are both O(log n)
+*/
+typedef struct {
+    int SIZE;
+    int TOTAL;
+    int WEIGHTS[MAX_RAND_CHOICES];
+    int TREE[MAX_RAND_CHOICES+1]; //TREE[i] is the sum of the weights (i - (i & -i)), i]
+} RandChoices;
+
+/**
+ * initRandChoices() - build a set of choices
+ *
+ * @choices - the choices to build
+ * @weights - weight of each choice (0 if unavaliable, 1 for uniform)
+ * @size - number of choices (at most MAX_RAND_CHOICES)
+*/
+void initRandChoices(RandChoices* choices, int weights[], int size);
+
+/**
+ * setRandChoiceWeight() - change the weight of a choice
+ *
+ * @choices - the choices
+ * @index - the choice to change
+ * @weight - the new weight (0 to remove the choice)
+*/
+void setRandChoiceWeight(RandChoices* choices, int index, int weight);
 
 /**
- * getRandIntNotIn() - returns a random integer between 0 and len(avaliable)
+ * getRandChoice() - pick a choice at random, with probability proportional to its weight
  *
- * @avaliable - is number avaliable
- * @numAvaliable - num avaliable
+ * @rng - the generator
+ * @choices - the choices (must have TOTAL > 0)
  * 
- * @return min <= rand < max
+ * @return the index of the choice
 */
-int getRandIntNotIn(int avaliable[], int numAvaliable);
+int getRandChoice(RandState* rng, RandChoices* choices);
 
 /**
  * initRand() - Initilize the random number generate
@@ -51,6 +108,13 @@ int getRandIntNotIn(int avaliable[], int numAvaliable);
 */
 void initRand();
 
+/**
+ * getNumHardwareThreads() - number of threads the machine can run at once
+ * 
+ * @return number of online processors (at least 1)
+*/
+int getNumHardwareThreads();
+
 char* toLowerCase(char* str);
 
 char* toUpperCase(char* str);
\ No newline at end of file